@@ -1,17 +1,51 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "item.h"
 #include "safe_reference.h"
 
+active_item_cache::cached_list::iterator active_item_cache::erase( cached_list &list,
+        const cached_list::iterator pos )
+{
+    positions.erase( pos->target );
+    return list.erase( pos );
+}
+
+void active_item_cache::find_positions()
+{
+    positions.clear();
+    for( std::pair<const int, cached_list> &kv : active_items ) {
+        for( cached_list::iterator it = kv.second.begin(); it != kv.second.end(); ++it ) {
+            positions[it->target] = cached_position{ kv.first, it };
+        }
+    }
+}
+
+active_item_cache::active_item_cache( const active_item_cache &other ) :
+    active_items( other.active_items ), special_items( other.special_items )
+{
+    find_positions();
+}
+
+active_item_cache &active_item_cache::operator=( const active_item_cache &other )
+{
+    if( this != &other ) {
+        active_items = other.active_items;
+        special_items = other.special_items;
+        find_positions();
+    }
+    return *this;
+}
+
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
-        item *const target = active_item.item_ref.get();
-        return !target || target == it;
-    } );
+    const auto found = positions.find( it );
+    if( found != positions.end() ) {
+        erase( active_items[found->second.speed], found->second.pos );
+    }
     if( it->can_revive() ) {
         special_items[ special_item_type::corpse ].remove_if( [it]( const item_reference & active_item ) {
             item *const target = active_item.item_ref.get();
@@ -30,12 +64,13 @@ void active_item_cache::remove( const item *it )
 void active_item_cache::add( item &it, point location )
 {
     // If the item is alread in the cache for some reason, don't add a second reference
-    std::list<item_reference> &target_list = active_items[it.processing_speed()];
-    if( std::find_if( target_list.begin(),
-    target_list.end(), [&it]( const item_reference & active_item_ref ) {
-    return &it == active_item_ref.item_ref.get();
-    } ) != target_list.end() ) {
-        return;
+    const auto found = positions.find( &it );
+    if( found != positions.end() ) {
+        if( found->second.pos->ref.item_ref.get() == &it ) {
+            return;
+        }
+        // A destroyed item that was at the same address
+        erase( active_items[found->second.speed], found->second.pos );
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].push_back( item_reference{ location, it.get_safe_reference() } );
@@ -43,29 +78,27 @@ void active_item_cache::add( item &it, point location )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].push_back( item_reference{ location, it.get_safe_reference() } );
     }
-    target_list.push_back( item_reference{ location, it.get_safe_reference() } );
+    const int speed = it.processing_speed();
+    cached_list &target_list = active_items[speed];
+    target_list.push_back( cached_item{ item_reference{ location, it.get_safe_reference() }, &it } );
+    positions[&it] = cached_position{ speed, std::prev( target_list.end() ) };
 }
 
 bool active_item_cache::empty() const
 {
-    for( std::pair<int, std::list<item_reference>> active_queue : active_items ) {
-        if( !active_queue.second.empty() ) {
-            return false;
-        }
-    }
-    return true;
+    return positions.empty();
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
+    for( std::pair<const int, cached_list> &kv : active_items ) {
+        for( cached_list::iterator it = kv.second.begin(); it != kv.second.end(); ) {
+            if( it->ref.item_ref ) {
+                all_cached_items.emplace_back( it->ref );
                 ++it;
             } else {
-                it = kv.second.erase( it );
+                it = erase( kv.second, it );
             }
         }
     }
@@ -75,18 +108,18 @@ std::vector<item_reference> active_item_cache::get()
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
     std::vector<item_reference> items_to_process;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
+    for( std::pair<const int, cached_list> &kv : active_items ) {
         // Rely on iteration logic to make sure the number is sane.
         int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
+        cached_list::iterator it = kv.second.begin();
         for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
+            if( it->ref.item_ref ) {
+                items_to_process.push_back( it->ref );
                 --num_to_process;
                 ++it;
             } else {
                 // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+                it = erase( kv.second, it );
             }
         }
         // Rotate the returned items to the end of their list so that the items that weren't
@@ -107,18 +140,18 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location -= delta;
+    for( std::pair<const int, cached_list> &pair : active_items ) {
+        for( cached_item &ci : pair.second ) {
+            ci.ref.location -= delta;
         }
     }
 }
 
 void active_item_cache::rotate_locations( int turns, const point &dim )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location = ir.location.rotate( turns, dim );
+    for( std::pair<const int, cached_list> &pair : active_items ) {
+        for( cached_item &ci : pair.second ) {
+            ci.ref.location = ci.ref.location.rotate( turns, dim );
         }
     }
 }
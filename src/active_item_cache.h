@@ -37,14 +37,37 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        // An entry of active_items, with the item it was added for, so the lookup of an item
+        // that has been destroyed can be dropped along with it
+        struct cached_item {
+            item_reference ref;
+            const item *target;
+        };
+        using cached_list = std::list<cached_item>;
+        struct cached_position {
+            int speed;
+            cached_list::iterator pos;
+        };
+
+        // Erases the entry from its list and the lookup, returns the next entry
+        cached_list::iterator erase( cached_list &list, cached_list::iterator pos );
+        // Fills the lookup from the lists, the iterators of a copy point into its own lists
+        void find_positions();
+
+        std::unordered_map<int, cached_list> active_items;
+        // Where each item is in active_items, so add() and remove() don't walk the lists
+        std::unordered_map<const item *, cached_position> positions;
         std::unordered_map<special_item_type, std::list<item_reference>> special_items;
 
     public:
+        active_item_cache() = default;
+        active_item_cache( const active_item_cache &other );
+        active_item_cache( active_item_cache && ) = default;
+        active_item_cache &operator=( const active_item_cache &other );
+        active_item_cache &operator=( active_item_cache && ) = default;
+
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
-         * Also removes any items that have been destroyed in the list containing it
          */
         void remove( const item *it );
 
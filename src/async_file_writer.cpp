@@ -0,0 +1,141 @@
+#include "async_file_writer.h"
+
+#include <exception>
+#include <ostream>
+#include <utility>
+
+#include "fstream_utils.h"
+#include "string_formatter.h"
+
+async_file_writer::async_file_writer()
+{
+    worker = std::thread( [this]() {
+        run();
+    } );
+}
+
+async_file_writer::~async_file_writer()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    work_available.notify_all();
+    worker.join();
+}
+
+void async_file_writer::queue( const std::string &path, std::string contents )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        failed.erase( path );
+        auto iter = pending.find( path );
+        if( iter == pending.end() ) {
+            order.push_back( path );
+            iter = pending.emplace( path, pending_file() ).first;
+        }
+        iter->second.contents = std::move( contents );
+        iter->second.generation++;
+    }
+    work_available.notify_one();
+}
+
+bool async_file_writer::pending_contents( const std::string &path, std::string &contents ) const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    const auto iter = pending.find( path );
+    if( iter != pending.end() ) {
+        contents = iter->second.contents;
+        return true;
+    }
+    const auto failed_iter = failed.find( path );
+    if( failed_iter != failed.end() ) {
+        contents = failed_iter->second;
+        return true;
+    }
+    return false;
+}
+
+bool async_file_writer::is_pending( const std::string &path ) const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return pending.count( path ) != 0 || failed.count( path ) != 0;
+}
+
+std::vector<std::string> async_file_writer::wait()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    work_done.wait( lock, [this]() {
+        return pending.empty();
+    } );
+    std::vector<std::string> result;
+    result.swap( errors );
+    return result;
+}
+
+std::vector<std::string> async_file_writer::take_errors()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    std::vector<std::string> result;
+    result.swap( errors );
+    return result;
+}
+
+void async_file_writer::retry_failed()
+{
+    std::unordered_map<std::string, std::string> retried;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        retried.swap( failed );
+    }
+    for( auto &file : retried ) {
+        queue( file.first, std::move( file.second ) );
+    }
+}
+
+void async_file_writer::run()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_available.wait( lock, [this]() {
+            return stopping || !order.empty();
+        } );
+        if( order.empty() ) {
+            // Only stop once everything queued is written
+            return;
+        }
+        const std::string path = order.front();
+        order.pop_front();
+        // Copied, so the entry stays readable through pending_contents during the write
+        const pending_file file = pending[path];
+
+        lock.unlock();
+        std::string error;
+        try {
+            write_to_file( path, [&file]( std::ostream & fout ) {
+                fout << file.contents;
+            } );
+        } catch( const std::exception &err ) {
+            error = string_format( "Failed to write \"%s\": %s", path, err.what() );
+        }
+        lock.lock();
+
+        if( !error.empty() ) {
+            errors.push_back( error );
+        }
+        const auto iter = pending.find( path );
+        if( iter->second.generation == file.generation ) {
+            if( !error.empty() ) {
+                // Nothing else has these contents any more, keep them for another try
+                failed[path] = std::move( iter->second.contents );
+            }
+            pending.erase( iter );
+        } else {
+            // Replaced while it was written, the new contents still need a write
+            order.push_back( path );
+        }
+        if( pending.empty() ) {
+            work_done.notify_all();
+        }
+    }
+}
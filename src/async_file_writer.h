@@ -0,0 +1,77 @@
+#pragma once
+#ifndef CATA_SRC_ASYNC_FILE_WRITER_H
+#define CATA_SRC_ASYNC_FILE_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Writes files on a background thread.
+ *
+ * Contents are handed over already serialized, so whatever they were made from can keep
+ * changing on the game thread while the file is being written. Queuing a file that is still
+ * waiting to be written replaces its contents.
+ *
+ * Writes go through @ref write_to_file, so a file is either fully replaced or left untouched.
+ * The contents of a failed write are kept, and still count as pending, until the file is queued
+ * again or @ref retry_failed is called.
+ */
+class async_file_writer
+{
+    public:
+        async_file_writer();
+        /** Waits for all queued writes. */
+        ~async_file_writer();
+
+        void queue( const std::string &path, std::string contents );
+
+        /**
+         * Gets the contents queued for @p path that may not be on disk yet.
+         * @return false if nothing is pending for that path, reading the file is fine then.
+         */
+        bool pending_contents( const std::string &path, std::string &contents ) const;
+        bool is_pending( const std::string &path ) const;
+
+        /**
+         * Blocks until everything queued so far is written.
+         * @return Error messages of the writes that failed since the last call.
+         */
+        std::vector<std::string> wait();
+        /** Returns error messages of the writes that failed since the last call, without waiting. */
+        std::vector<std::string> take_errors();
+        /** Queues the files whose last write failed again. */
+        void retry_failed();
+
+    private:
+        struct pending_file {
+            std::string contents;
+            // Changes whenever the contents are replaced
+            int generation = 0;
+        };
+
+        void run();
+
+        mutable std::mutex mutex;
+        // Signals the worker that there's something to write or that it should stop
+        std::condition_variable work_available;
+        // Signals waiting threads that the queue got empty
+        std::condition_variable work_done;
+        // Paths in the order they were first queued
+        std::deque<std::string> order;
+        std::unordered_map<std::string, pending_file> pending;
+        // Contents of the files whose last write failed
+        std::unordered_map<std::string, std::string> failed;
+        std::vector<std::string> errors;
+        bool stopping = false;
+        std::thread worker;
+};
+
+#endif // CATA_SRC_ASYNC_FILE_WRITER_H
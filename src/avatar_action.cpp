@@ -75,8 +75,8 @@ static const trait_id trait_SHELL2( "SHELL2" );
 static const std::string flag_ALLOWS_REMOTE_USE( "ALLOWS_REMOTE_USE" );
 static const std::string flag_DIG_TOOL( "DIG_TOOL" );
 static const std::string flag_NO_UNWIELD( "NO_UNWIELD" );
-static const std::string flag_RAMP_END( "RAMP_END" );
-static const std::string flag_SWIMMABLE( "SWIMMABLE" );
+
+static const ter_furn_flag flag_RAMP_END( "RAMP_END" );
 
 #define dbg(x) DebugLog((x), DC::SDL)
 
@@ -324,9 +324,9 @@ bool avatar_action::move( avatar &you, map &m, const tripoint &d )
             return false;
         }
     }
-    bool toSwimmable = m.has_flag( flag_SWIMMABLE, dest_loc );
+    bool toSwimmable = m.has_flag( TFLAG_SWIMMABLE, dest_loc );
     bool toDeepWater = m.has_flag( TFLAG_DEEP_WATER, dest_loc );
-    bool fromSwimmable = m.has_flag( flag_SWIMMABLE, you.pos() );
+    bool fromSwimmable = m.has_flag( TFLAG_SWIMMABLE, you.pos() );
     bool fromDeepWater = m.has_flag( TFLAG_DEEP_WATER, you.pos() );
     bool fromBoat = veh0 != nullptr && veh0->is_in_water();
     bool toBoat = veh1 != nullptr && veh1->is_in_water();
@@ -484,7 +484,7 @@ bool avatar_action::ramp_move( avatar &you, map &m, const tripoint &dest_loc )
 
 void avatar_action::swim( map &m, avatar &you, const tripoint &p )
 {
-    if( !m.has_flag( flag_SWIMMABLE, p ) ) {
+    if( !m.has_flag( TFLAG_SWIMMABLE, p ) ) {
         debugmsg( "Tried to swim in %s!", m.tername( p ) );
         return;
     }
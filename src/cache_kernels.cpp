@@ -0,0 +1,113 @@
+#include "cache_kernels.h"
+
+#include <algorithm>
+
+#include "shadowcasting.h"
+
+// MSVC never defines __SSE2__, x64 always has it and x86 has it with /arch:SSE2 or later
+#if ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) ) && \
+    !defined(CATA_NO_SIMD)
+#   define CATA_CACHE_KERNELS_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace cache_kernels
+{
+
+#if defined(CATA_CACHE_KERNELS_SSE2)
+
+// Values handled by one SSE2 register
+static constexpr size_t lanes = 4;
+
+void fill( float *cache, const float value, const size_t count )
+{
+    const __m128 v = _mm_set1_ps( value );
+    size_t i = 0;
+    for( ; i + lanes <= count; i += lanes ) {
+        _mm_storeu_ps( cache + i, v );
+    }
+    for( ; i < count; ++i ) {
+        cache[i] = value;
+    }
+}
+
+void elementwise_max( const float *l, const float *r, float *out, const size_t count )
+{
+    size_t i = 0;
+    for( ; i + lanes <= count; i += lanes ) {
+        _mm_storeu_ps( out + i, _mm_max_ps( _mm_loadu_ps( l + i ), _mm_loadu_ps( r + i ) ) );
+    }
+    for( ; i < count; ++i ) {
+        out[i] = std::max( l[i], r[i] );
+    }
+}
+
+void multiply( const float *l, const float *r, float *out, const size_t count )
+{
+    size_t i = 0;
+    for( ; i + lanes <= count; i += lanes ) {
+        _mm_storeu_ps( out + i, _mm_mul_ps( _mm_loadu_ps( l + i ), _mm_loadu_ps( r + i ) ) );
+    }
+    for( ; i < count; ++i ) {
+        out[i] = l[i] * r[i];
+    }
+}
+
+void quadrant_max( const four_quadrants *light, float *out, const size_t count )
+{
+    size_t i = 0;
+    for( ; i + lanes <= count; i += lanes ) {
+        // One tile per register, transposed so each register holds one quadrant of four tiles
+        __m128 a = _mm_loadu_ps( light[i].values.data() );
+        __m128 b = _mm_loadu_ps( light[i + 1].values.data() );
+        __m128 c = _mm_loadu_ps( light[i + 2].values.data() );
+        __m128 d = _mm_loadu_ps( light[i + 3].values.data() );
+        _MM_TRANSPOSE4_PS( a, b, c, d );
+        _mm_storeu_ps( out + i, _mm_max_ps( _mm_max_ps( a, b ), _mm_max_ps( c, d ) ) );
+    }
+    for( ; i < count; ++i ) {
+        out[i] = light[i].max();
+    }
+}
+
+bool vectorized()
+{
+    return true;
+}
+
+#else
+
+void fill( float *cache, const float value, const size_t count )
+{
+    std::fill_n( cache, count, value );
+}
+
+void elementwise_max( const float *l, const float *r, float *out, const size_t count )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        out[i] = std::max( l[i], r[i] );
+    }
+}
+
+void multiply( const float *l, const float *r, float *out, const size_t count )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        out[i] = l[i] * r[i];
+    }
+}
+
+void quadrant_max( const four_quadrants *light, float *out, const size_t count )
+{
+    for( size_t i = 0; i < count; ++i ) {
+        out[i] = light[i].max();
+    }
+}
+
+bool vectorized()
+{
+    return false;
+}
+
+#endif
+
+} // namespace cache_kernels
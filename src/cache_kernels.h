@@ -0,0 +1,33 @@
+#pragma once
+#ifndef CATA_SRC_CACHE_KERNELS_H
+#define CATA_SRC_CACHE_KERNELS_H
+
+#include <cstddef>
+
+struct four_quadrants;
+
+/**
+ * Bulk passes over the per-tile float caches of a level (see @ref level_cache), which are
+ * laid out as contiguous arrays.
+ *
+ * SSE2 is used when the compiler targets it, unless CATA_NO_SIMD is defined at build time.
+ * Both versions give exactly the same results.
+ */
+namespace cache_kernels
+{
+
+/** Sets the first @p count values of @p cache to @p value. */
+void fill( float *cache, float value, size_t count );
+/** out[i] = max( l[i], r[i] ), @p out may be either input. */
+void elementwise_max( const float *l, const float *r, float *out, size_t count );
+/** out[i] = l[i] * r[i], @p out may be either input. */
+void multiply( const float *l, const float *r, float *out, size_t count );
+/** out[i] = light[i].max() */
+void quadrant_max( const four_quadrants *light, float *out, size_t count );
+
+/** Whether the SIMD versions were compiled in. */
+bool vectorized();
+
+} // namespace cache_kernels
+
+#endif // CATA_SRC_CACHE_KERNELS_H
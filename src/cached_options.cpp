@@ -10,6 +10,9 @@ int message_cooldown;
 bool trigdist;
 bool fov_3d;
 int fov_3d_z_range;
+bool parallel_shadowcasting;
+bool parallel_monster_planning;
+int field_idle_interval = 1;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
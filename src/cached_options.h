@@ -49,6 +49,15 @@ extern bool fov_3d;
 /** 3D FoV range, in Z levels, in both directions. */
 extern int fov_3d_z_range;
 
+/** Cast light and field of vision on the worker pool, see @ref get_worker_pool. */
+extern bool parallel_shadowcasting;
+
+/** Let monsters plan their moves on the worker pool, see @ref get_worker_pool. */
+extern bool parallel_monster_planning;
+
+/** Turns between updates of fields with no creature nearby, see map::process_fields. */
+extern int field_idle_interval;
+
 /** Using isometric tileset. */
 extern bool tile_iso;
 
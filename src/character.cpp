@@ -9782,9 +9782,16 @@ bool Character::is_visible_in_range( const Creature &critter, const int range )
     return sees( critter ) && rl_dist( pos(), critter.pos() ) <= range;
 }
 
+int Character::max_sees_range() const
+{
+    return std::max( unimpaired_range(), MAX_CLAIRVOYANCE );
+}
+
 std::vector<Creature *> Character::get_visible_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    const int search_range = std::min( range, max_sees_range() );
+    return g->get_creatures_in_radius_if( pos(), search_range, search_range,
+    [this, range]( const Creature & critter ) -> bool {
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
         rl_dist( pos(), critter.pos() ) <= range && sees( critter );
     } );
@@ -9792,7 +9799,9 @@ std::vector<Creature *> Character::get_visible_creatures( const int range ) cons
 
 std::vector<Creature *> Character::get_hostile_creatures( int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    const int search_range = std::min( range, max_sees_range() );
+    return g->get_creatures_in_radius_if( pos(), search_range, search_range,
+    [this, range]( const Creature & critter ) -> bool {
         // Fixes circular distance range for ranged attacks
         float dist_to_creature = std::round( rl_dist_exact( pos(), critter.pos() ) );
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
@@ -438,6 +438,8 @@ class Character : public Creature, public visitable<Character>
         int sight_range( int light_level ) const override;
         /** Returns the player maximum vision range factoring in mutations, diseases, and other effects */
         int  unimpaired_range() const;
+        /** Returns the distance beyond which sees( const Creature & ) never succeeds */
+        int max_sees_range() const;
         /** Returns true if overmap tile is within player line-of-sight */
         bool overmap_los( const tripoint &omt, int sight_points );
         /** Returns the distance the player can see on the overmap */
@@ -28,6 +28,7 @@
 #include "output.h"
 #include "point.h"
 #include "recipe.h"
+#include "recipe_availability.h"
 #include "recipe_dictionary.h"
 #include "requirements.h"
 #include "string_formatter.h"
@@ -55,6 +56,9 @@ std::vector<std::string> craft_cat_list;
 std::map<std::string, std::vector<std::string> > craft_subcat_list;
 std::map<std::string, std::string> normalized_names;
 
+// Kept between uses of the menu, only recipes affected by changed items are checked again
+static recipe_availability single_batch_availability;
+
 static bool query_is_yes( const std::string &query );
 static void draw_hidden_amount( const catacurses::window &w, int amount, int num_recipe );
 static void draw_can_craft_indicator( const catacurses::window &w, const recipe &rec );
@@ -242,18 +246,13 @@ const recipe *select_crafting_recipe( int &batch_size )
     struct availability {
         availability( const recipe *r, int batch_size, bool known ) {
             this->known = known;
-            const inventory &inv = get_avatar().crafting_inventory();
-            auto all_items_filter = r->get_component_filter( recipe_filter_flags::none );
-            auto no_rotten_filter = r->get_component_filter( recipe_filter_flags::no_rotten );
-            const deduped_requirement_data &req = r->deduped_requirements();
-            could_craft_if_knew = req.can_make_with_inventory(
-                                      inv, all_items_filter, batch_size, cost_adjustment::start_only );
+            const recipe_availability::result res = batch_size == 1
+                    ? single_batch_availability.get( *r )
+                    : recipe_availability::evaluate( *r, get_avatar().crafting_inventory(), batch_size );
+            could_craft_if_knew = res.could_craft;
             can_craft = known && could_craft_if_knew;
-            can_craft_non_rotten = req.can_make_with_inventory(
-                                       inv, no_rotten_filter, batch_size, cost_adjustment::start_only );
-            const requirement_data &simple_req = r->simple_requirements();
-            apparently_craftable = simple_req.can_make_with_inventory(
-                                       inv, all_items_filter, batch_size, cost_adjustment::start_only );
+            can_craft_non_rotten = res.could_craft_non_rotten;
+            apparently_craftable = res.apparently_craftable;
         }
         bool can_craft;
         bool can_craft_non_rotten;
@@ -313,6 +312,7 @@ const recipe *select_crafting_recipe( int &batch_size )
     ctxt.register_action( "TOGGLE_UNAVAILABLE" );
 
     const inventory &crafting_inv = u.crafting_inventory();
+    single_batch_availability.update( crafting_inv );
     const std::vector<npc *> helpers = u.get_crafting_helpers();
     std::string filterstring;
 
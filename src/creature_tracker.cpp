@@ -6,7 +6,10 @@
 #include <string>
 #include <utility>
 
+#include "coordinate_conversions.h"
 #include "debug.h"
+#include "game_constants.h"
+#include "monfaction.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -86,7 +89,7 @@ bool Creature_tracker::add( shared_ptr_fast<monster> critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -136,8 +139,8 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        erase_location( critter.pos() );
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -156,7 +159,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( pos_iter->first );
         return;
     }
 
@@ -167,10 +170,129 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( iter->first );
     }
 }
 
+void Creature_tracker::set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter )
+{
+    shared_ptr_fast<monster> &slot = monsters_by_location[pos];
+    if( slot == critter ) {
+        return;
+    }
+    std::vector<monster *> &cell = monsters_by_cell[ms_to_sm_copy( pos )];
+    if( slot ) {
+        // Overwriting another (dead) monster, it must leave the cell as well.
+        const auto cell_iter = std::find( cell.begin(), cell.end(), slot.get() );
+        if( cell_iter != cell.end() ) {
+            *cell_iter = cell.back();
+            cell.pop_back();
+        }
+    }
+    slot = critter;
+    cell.push_back( critter.get() );
+}
+
+void Creature_tracker::erase_location( const tripoint &pos )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter == monsters_by_location.end() ) {
+        return;
+    }
+    const auto cell_iter = monsters_by_cell.find( ms_to_sm_copy( pos ) );
+    if( cell_iter != monsters_by_cell.end() ) {
+        std::vector<monster *> &cell = cell_iter->second;
+        const auto mon_iter = std::find( cell.begin(), cell.end(), iter->second.get() );
+        if( mon_iter != cell.end() ) {
+            *mon_iter = cell.back();
+            cell.pop_back();
+        }
+        if( cell.empty() ) {
+            monsters_by_cell.erase( cell_iter );
+        }
+    }
+    monsters_by_location.erase( iter );
+}
+
+void Creature_tracker::clear_locations()
+{
+    monsters_by_location.clear();
+    monsters_by_cell.clear();
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, const int radius,
+        const int radiusz ) const
+{
+    return find_in_radius_if( center, radius, radiusz, nullptr );
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius( const tripoint &center, const int radius,
+        const int radiusz, const mfaction_id &faction ) const
+{
+    const mfaction_id &player_faction = monfactions::player_faction();
+    return find_in_radius_if( center, radius, radiusz, [&]( const monster & critter ) {
+        return ( critter.friendly == 0 ? critter.faction : player_faction ) == faction;
+    } );
+}
+
+std::vector<monster *> Creature_tracker::find_in_radius_if( const tripoint &center,
+        const int radius, const int radiusz,
+        const std::function<bool( const monster & )> &pred ) const
+{
+    std::vector<monster *> result;
+    const tripoint min_pos( center.x - radius, center.y - radius,
+                            std::max( center.z - radiusz, -OVERMAP_DEPTH ) );
+    const tripoint max_pos( center.x + radius, center.y + radius,
+                            std::min( center.z + radiusz, OVERMAP_HEIGHT ) );
+    const tripoint min_cell = ms_to_sm_copy( min_pos );
+    const tripoint max_cell = ms_to_sm_copy( max_pos );
+
+    const auto collect = [&]( const std::vector<monster *> &cell ) {
+        for( monster *critter : cell ) {
+            const tripoint &p = critter->pos();
+            if( critter->is_dead() ||
+                p.x < min_pos.x || p.x > max_pos.x ||
+                p.y < min_pos.y || p.y > max_pos.y ||
+                p.z < min_pos.z || p.z > max_pos.z ) {
+                continue;
+            }
+            if( !pred || pred( *critter ) ) {
+                result.push_back( critter );
+            }
+        }
+    };
+
+    const int cells_in_box = ( max_cell.x - min_cell.x + 1 ) * ( max_cell.y - min_cell.y + 1 ) *
+                             ( max_cell.z - min_cell.z + 1 );
+    if( cells_in_box <= 0 ) {
+        return result;
+    }
+    if( static_cast<size_t>( cells_in_box ) > monsters_by_cell.size() ) {
+        // Sparse population: walking the occupied cells is cheaper than probing the box.
+        for( const auto &cell : monsters_by_cell ) {
+            const tripoint &c = cell.first;
+            if( c.x >= min_cell.x && c.x <= max_cell.x &&
+                c.y >= min_cell.y && c.y <= max_cell.y &&
+                c.z >= min_cell.z && c.z <= max_cell.z ) {
+                collect( cell.second );
+            }
+        }
+        return result;
+    }
+    tripoint c;
+    for( c.z = min_cell.z; c.z <= max_cell.z; c.z++ ) {
+        for( c.y = min_cell.y; c.y <= max_cell.y; c.y++ ) {
+            for( c.x = min_cell.x; c.x <= max_cell.x; c.x++ ) {
+                const auto iter = monsters_by_cell.find( c );
+                if( iter != monsters_by_cell.end() ) {
+                    collect( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
 void Creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -199,17 +321,17 @@ void Creature_tracker::remove( const monster &critter )
 void Creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
-    monsters_by_location.clear();
+    clear_locations();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -228,13 +350,17 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+    }
+    if( first_ptr ) {
+        erase_location( first.pos() );
+    }
+    if( second_ptr ) {
+        erase_location( second.pos() );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -244,10 +370,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -3,6 +3,7 @@
 #define CATA_SRC_CREATURE_TRACKER_H
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -91,11 +92,41 @@ class Creature_tracker
             return monster_faction_map_;
         }
 
+        /**
+         * Returns living monsters within @p radius (square distance) of @p center on the
+         * x/y plane and within @p radiusz z-levels of it.
+         * Only the cells of the spatial index that overlap the query box are visited, so
+         * the cost scales with the number of monsters near @p center instead of with the
+         * total number of tracked monsters.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius,
+                                               int radiusz = 0 ) const;
+        /** Same as above, but only returns monsters for which @p pred returns true. */
+        std::vector<monster *> find_in_radius_if( const tripoint &center, int radius, int radiusz,
+                const std::function<bool( const monster & )> &pred ) const;
+        /**
+         * Same as above, but only returns monsters that belong to the given faction.
+         * Friendly monsters belong to the "player" faction, see @ref factions.
+         */
+        std::vector<monster *> find_in_radius( const tripoint &center, int radius, int radiusz,
+                                               const mfaction_id &faction ) const;
+
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * Spatial index over @ref monsters_by_location: the monsters in it, bucketed by the
+         * submap-sized cell their key falls into. Empty cells are not stored.
+         * Must only be modified through @ref set_location / @ref erase_location.
+         */
+        std::unordered_map<tripoint, std::vector<monster *>> monsters_by_cell;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Stores @p critter at @p pos in @ref monsters_by_location and the spatial index. */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Erases the entry at @p pos from @ref monsters_by_location and the spatial index. */
+        void erase_location( const tripoint &pos );
+        void clear_locations();
 };
 
 #endif // CATA_SRC_CREATURE_TRACKER_H
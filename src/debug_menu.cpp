@@ -86,6 +86,7 @@
 #include "string_utils.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -181,6 +182,7 @@ enum debug_menu_index {
     DEBUG_TEST_MAP_EXTRA_DISTRIBUTION,
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_HOUR_TIMER,
+    DEBUG_TURN_PROFILER,
     DEBUG_NESTED_MAPGEN
 };
 
@@ -249,6 +251,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER, true, 'P', _( "Turn profiler" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -1232,6 +1235,65 @@ void benchmark( const int max_difference, bench_kind kind )
              difference / 1000.0, 1000.0 * draw_counter / static_cast<double>( difference ) );
 }
 
+static void turn_profiler_menu()
+{
+#if defined(CATA_NO_PROFILER)
+    popup( _( "This binary was compiled without the turn profiler." ) );
+#else
+    enum {
+        TOGGLE,
+        SHOW_AVERAGES,
+        EXPORT_TRACE,
+        CLEAR
+    };
+    uilist menu;
+    menu.text = turn_profiler::enabled() ? _( "Turn profiler is running." ) :
+                _( "Turn profiler is stopped." );
+    menu.addentry( TOGGLE, true, 't', turn_profiler::enabled() ? _( "Stop profiling" ) :
+                   _( "Start profiling" ) );
+    menu.addentry( SHOW_AVERAGES, turn_profiler::recorded_turns() > 0, 'a', _( "Show averages" ) );
+    menu.addentry( EXPORT_TRACE, true, 'e', _( "Export trace" ) );
+    menu.addentry( CLEAR, true, 'c', _( "Clear recorded data" ) );
+    menu.query();
+
+    switch( menu.ret ) {
+        case TOGGLE:
+            turn_profiler::set_enabled( !turn_profiler::enabled() );
+            break;
+        case SHOW_AVERAGES: {
+            std::string text = string_format( "Average of the last %d turns\n\n",
+                                              turn_profiler::recorded_turns() );
+            text += string_format( "%-40s %10s %10s %8s\n", "zone", "avg ms", "max ms", "calls" );
+            for( const turn_profiler::zone_average &avg : turn_profiler::averages() ) {
+                text += string_format( "%-40s %10.3f %10.3f %8.1f\n", avg.name, avg.milliseconds,
+                                       avg.max_milliseconds, avg.calls );
+            }
+            DebugLog( DL::Info, DC::Main ) << "Turn profile:\n" << text;
+            popup( "%s", text );
+        }
+        break;
+        case EXPORT_TRACE: {
+            std::time_t time = std::time( nullptr );
+            std::stringstream date_buffer;
+            date_buffer << std::put_time( std::gmtime( &time ), "%F_%H-%M-%S_%z" );
+            const std::string path = g->get_world_base_save_path() + "/" +
+                                     ensure_valid_file_name( "turn_profile_" + date_buffer.str() + ".json" );
+            if( turn_profiler::export_trace( path ) ) {
+                popup( _( "Trace written to %s" ), path );
+            } else {
+                popup( _( "Failed to write the trace to %s" ), path );
+            }
+        }
+        break;
+        case CLEAR:
+            turn_profiler::clear();
+            break;
+        default:
+            break;
+    }
+#endif
+}
+
 void debug()
 {
     bool debug_menu_has_hotkey = hotkey_for_action( ACTION_DEBUG, false ) != -1;
@@ -1689,6 +1751,9 @@ void debug()
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case DEBUG_TURN_PROFILER:
+            turn_profiler_menu();
+            break;
         case DEBUG_CHANGE_TIME: {
             auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
                 const auto text = string_input_popup()
@@ -10,6 +10,7 @@
 #include "submap.h"
 #include "options.h"
 #include "overmapbuffer.h"
+#include "turn_profiler.h"
 
 static distribution_grid empty_grid( {}, MAPBUFFER );
 
@@ -257,6 +258,7 @@ std::uintptr_t distribution_grid_tracker::debug_grid_id( const tripoint &omp ) c
 
 void distribution_grid_tracker::update( time_point to )
 {
+    CATA_PROFILE_ZONE( "distribution_grid_tracker::update" );
     // TODO: Don't recalc this every update
     std::unordered_set<const distribution_grid *> updated;
     for( auto &pr : parent_distribution_grids ) {
@@ -19,9 +19,10 @@
 class field_entry
 {
     public:
-        field_entry() : type( fd_null ), intensity( 1 ), age( 0_turns ), is_alive( false ) { }
+        field_entry() : type( fd_null ), intensity( 1 ), age( 0_turns ), is_alive( false ),
+            added( calendar::turn ) { }
         field_entry( const field_type_id &t, const int i, const time_duration &a ) : type( t ),
-            intensity( i ), age( a ), is_alive( true ) { }
+            intensity( i ), age( a ), is_alive( true ), added( calendar::turn ) { }
 
         nc_color color() const;
 
@@ -85,6 +86,11 @@ class field_entry
             return type.obj().get_name( intensity - 1 );
         }
 
+        /// Turn this entry was created or loaded on, not saved.
+        time_point get_field_added() const {
+            return added;
+        }
+
         //Returns true if this is an active field, false if it should be removed.
         bool is_field_alive() {
             return is_alive;
@@ -117,6 +123,8 @@ class field_entry
         time_duration age;
         // True if this is an active field, false if it should be destroyed next check.
         bool is_alive;
+        // Limits how many skipped turns an idle submap's processing catches up on.
+        time_point added;
 };
 
 /**
@@ -0,0 +1,158 @@
+#include "file_prefetcher.h"
+
+#include <algorithm>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <utility>
+
+#include "filesystem.h"
+#include "fstream_utils.h"
+
+// A quad file is tens of kilobytes, this keeps the staged data within a few megabytes
+static constexpr size_t max_finished_reads = 128;
+
+file_prefetcher::file_prefetcher()
+{
+    worker = std::thread( [this]() {
+        run();
+    } );
+}
+
+file_prefetcher::~file_prefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+        queue.clear();
+    }
+    work_available.notify_all();
+    worker.join();
+}
+
+void file_prefetcher::request( const std::string &path )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        if( entries.count( path ) != 0 ) {
+            return;
+        }
+        entry &added = entries[path];
+        added.generation = next_generation++;
+        queue.push_back( path );
+    }
+    work_available.notify_one();
+}
+
+bool file_prefetcher::take( const std::string &path, std::string &contents, bool &exists )
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    auto iter = entries.find( path );
+    if( iter == entries.end() ) {
+        return false;
+    }
+    if( iter->second.state == entry_state::queued ) {
+        // Not started yet, the caller reading it directly is just as fast
+        queue.erase( std::find( queue.begin(), queue.end(), path ) );
+        entries.erase( iter );
+        return false;
+    }
+    const int generation = iter->second.generation;
+    read_finished.wait( lock, [&]() {
+        iter = entries.find( path );
+        return iter == entries.end() || iter->second.generation != generation ||
+               iter->second.state == entry_state::done;
+    } );
+    if( iter == entries.end() || iter->second.generation != generation ) {
+        // The read failed
+        return false;
+    }
+    contents = std::move( iter->second.contents );
+    exists = iter->second.exists;
+    entries.erase( iter );
+    finished.erase( std::find( finished.begin(), finished.end(), path ) );
+    return true;
+}
+
+void file_prefetcher::discard( const std::string &path )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    const auto iter = entries.find( path );
+    if( iter == entries.end() ) {
+        return;
+    }
+    if( iter->second.state == entry_state::queued ) {
+        queue.erase( std::find( queue.begin(), queue.end(), path ) );
+    } else if( iter->second.state == entry_state::done ) {
+        finished.erase( std::find( finished.begin(), finished.end(), path ) );
+    }
+    // A read in progress notices the missing entry when it's done
+    entries.erase( iter );
+}
+
+void file_prefetcher::clear()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    queue.clear();
+    finished.clear();
+    entries.clear();
+}
+
+void file_prefetcher::evict()
+{
+    while( finished.size() > max_finished_reads ) {
+        entries.erase( finished.front() );
+        finished.pop_front();
+    }
+}
+
+void file_prefetcher::run()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_available.wait( lock, [this]() {
+            return stopping || !queue.empty();
+        } );
+        if( stopping ) {
+            return;
+        }
+        const std::string path = queue.front();
+        queue.pop_front();
+        entry &current = entries[path];
+        current.state = entry_state::reading;
+        const int generation = current.generation;
+
+        lock.unlock();
+        bool ok = true;
+        bool exists = false;
+        std::string contents;
+        try {
+            exists = file_exist( path );
+            if( exists ) {
+                cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( path ) );
+                ok = fin.is_open();
+                if( ok ) {
+                    contents.assign( std::istreambuf_iterator<char>( *fin ), std::istreambuf_iterator<char>() );
+                    ok = !fin.bad();
+                }
+            }
+        } catch( const std::exception & ) {
+            ok = false;
+        }
+        lock.lock();
+
+        const auto iter = entries.find( path );
+        if( iter != entries.end() && iter->second.generation == generation ) {
+            if( ok ) {
+                iter->second.state = entry_state::done;
+                iter->second.exists = exists;
+                iter->second.contents = std::move( contents );
+                finished.push_back( path );
+                evict();
+            } else {
+                entries.erase( iter );
+            }
+        }
+        read_finished.notify_all();
+    }
+}
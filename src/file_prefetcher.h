@@ -0,0 +1,74 @@
+#pragma once
+#ifndef CATA_SRC_FILE_PREFETCHER_H
+#define CATA_SRC_FILE_PREFETCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+#include <unordered_map>
+
+/**
+ * Reads files on a background thread before they are needed.
+ *
+ * Only the raw contents are read ahead, parsing them stays with the caller. A file that
+ * couldn't be read is simply forgotten, so the caller reads it again itself and reports the
+ * error as usual.
+ */
+class file_prefetcher
+{
+    public:
+        file_prefetcher();
+        /** Abandons everything that wasn't read yet. */
+        ~file_prefetcher();
+
+        /** Queues @p path to be read, unless it was already requested. */
+        void request( const std::string &path );
+
+        /**
+         * Takes the contents read ahead for @p path, waiting if it is being read right now.
+         * @param exists Set to whether the file existed when it was read.
+         * @return false if @p path wasn't read ahead, the caller has to read it itself then.
+         */
+        bool take( const std::string &path, std::string &contents, bool &exists );
+
+        /** Forgets @p path, for example because the file is about to be replaced. */
+        void discard( const std::string &path );
+        /** Forgets everything. */
+        void clear();
+
+    private:
+        enum class entry_state : int {
+            queued,
+            reading,
+            done,
+        };
+        struct entry {
+            entry_state state = entry_state::queued;
+            bool exists = false;
+            std::string contents;
+            // Distinguishes a request from an earlier, discarded request for the same path
+            int generation = 0;
+        };
+
+        void run();
+        // Drops the oldest finished reads beyond the limit
+        void evict();
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable read_finished;
+        std::deque<std::string> queue;
+        // Finished reads, oldest first
+        std::deque<std::string> finished;
+        std::unordered_map<std::string, entry> entries;
+        int next_generation = 0;
+        bool stopping = false;
+        std::thread worker;
+};
+
+#endif // CATA_SRC_FILE_PREFETCHER_H
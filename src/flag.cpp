@@ -74,6 +74,17 @@ const json_flag &json_flag::get( const std::string &id )
     return f_id.is_valid() ? *f_id : null_value;
 }
 
+flag_id json_flag::find( const std::string &id )
+{
+    const flag_str_id f_id( id );
+    return f_id.is_valid() ? f_id.id() : flag_id( -1 );
+}
+
+size_t json_flag::count()
+{
+    return json_flags_all.size();
+}
+
 void json_flag::load( const JsonObject &jo, const std::string & )
 {
     // TODO: mark fields as mandatory where appropriate
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_FLAG_H
 #define CATA_SRC_FLAG_H
 
+#include <cstddef>
 #include <set>
 #include <string>
 
@@ -26,6 +27,15 @@ class json_flag
         /** Fetches flag definition (or null flag if not found) */
         static const json_flag &get( const std::string &id );
 
+        /**
+         * Fetches the dense integer id of a flag, which is invalid if the flag isn't defined.
+         * Unlike @ref flag_str_id::id this doesn't complain about unknown flags.
+         */
+        static flag_id find( const std::string &id );
+
+        /** Number of loaded flags, the ids of all of them are below it */
+        static size_t count();
+
         /** Get informative text for display in UI */
         std::string info() const {
             return info_.translated();
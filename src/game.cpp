@@ -42,6 +42,7 @@
 #include "basecamp.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "character.h"
@@ -146,6 +147,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -158,6 +160,7 @@
 #include "vpart_range.h"
 #include "wcwidth.h"
 #include "weather.h"
+#include "worker_pool.h"
 #include "worldfactory.h"
 
 class computer;
@@ -203,6 +206,7 @@ static const efftype_id effect_bouldering( "bouldering" );
 static const efftype_id effect_contacts( "contacts" );
 static const efftype_id effect_docile( "docile" );
 static const efftype_id effect_downed( "downed" );
+static const efftype_id effect_dragging( "dragging" );
 static const efftype_id effect_drunk( "drunk" );
 static const efftype_id effect_evil( "evil" );
 static const efftype_id effect_flu( "flu" );
@@ -235,6 +239,13 @@ static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction
 
 static const faction_id your_followers( "your_followers" );
 
+static const ter_furn_flag flag_BARRICADABLE_DOOR( "BARRICADABLE_DOOR" );
+static const ter_furn_flag flag_BARRICADABLE_DOOR_DAMAGED( "BARRICADABLE_DOOR_DAMAGED" );
+static const ter_furn_flag flag_BARRICADABLE_DOOR_REINFORCED( "BARRICADABLE_DOOR_REINFORCED" );
+static const ter_furn_flag flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag flag_MOUNTABLE( "MOUNTABLE" );
+static const ter_furn_flag flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+
 #if defined(__ANDROID__)
 extern std::map<std::string, std::list<input_event>> quick_shortcuts_map;
 extern bool add_best_key_for_action_to_quick_shortcuts( action_id action,
@@ -1390,11 +1401,15 @@ bool game::do_turn()
     if( is_game_over() ) {
         return cleanup_at_end();
     }
+    turn_profiler::next_turn();
     // Actual stuff
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // Not set up when turns are run without starting a game, as in tests
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
 
@@ -4306,11 +4321,58 @@ void game::cleanup_dead()
     critter_died = false;
 }
 
+/**
+ * Lets the monsters that are about to move choose their targets on the worker pool.
+ * Planning reads the map caches and the other creatures, but only writes to the planning
+ * monster itself, as long as nothing moves meanwhile. Monsters whose plans touch more than
+ * that (friendly, riding, operating, dragging or smart ones) are left for the serial pass.
+ * Each monster draws its random numbers from its own engine, seeded in a fixed order, so a
+ * seeded game plays the same regardless of how the work is spread.
+ * @return the monsters that made their plans.
+ */
+static std::unordered_set<const monster *> plan_monsters_in_parallel( const game &g )
+{
+    const Creature_tracker &tracker = *g.critter_tracker;
+    std::vector<monster *> planners;
+    for( const shared_ptr_fast<monster> &critter_ptr : tracker.get_monsters_list() ) {
+        monster &critter = *critter_ptr;
+        if( critter.is_dead() || critter.moves <= 0 || critter.friendly != 0 ||
+            critter.has_effect( effect_ridden ) || critter.has_effect( effect_ai_controlled ) ||
+            critter.has_effect( effect_dragging ) || critter.has_flag( MF_PRIORITIZE_TARGETS ) ||
+            critter.type->has_special_attack( "OPERATE" ) ||
+            tracker.factions().count( critter.faction ) == 0 ) {
+            continue;
+        }
+        planners.push_back( &critter );
+    }
+    if( planners.empty() ) {
+        return {};
+    }
+
+    // Fill the light levels while only this thread runs, planning looks them up
+    for( int z = 0; z <= OVERMAP_HEIGHT; ++z ) {
+        g.natural_light_level( z );
+    }
+    std::vector<unsigned int> seeds;
+    seeds.reserve( planners.size() );
+    for( size_t i = 0; i < planners.size(); ++i ) {
+        seeds.push_back( rng_bits() );
+    }
+
+    get_worker_pool().run( planners.size(), [&]( size_t i ) {
+        cata_default_random_engine engine( seeds[i] );
+        rng_engine_override use_engine( engine );
+        planners[i]->plan();
+    } );
+    return std::unordered_set<const monster *>( planners.begin(), planners.end() );
+}
+
 void game::monmove()
 {
+    CATA_PROFILE_ZONE( "game::monmove" );
     cleanup_dead();
 
-    for( monster &critter : all_monsters() ) {
+    const auto start_turn = [this]( monster & critter ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
             std::string msg = string_format( "%s can't move to its location!  %s  %s", critter.name(),
@@ -4342,13 +4404,18 @@ void game::monmove()
             }
             critter.try_reproduce();
         }
+    };
+
+    // A monster that already planned skips planning for its first move
+    const auto act = [this]( monster & critter, bool planned ) {
         while( critter.moves > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
-            if( !critter.has_effect( effect_ai_controlled ) ) {
+            if( !planned && !critter.has_effect( effect_ai_controlled ) ) {
                 // Formulate a path to follow
                 critter.plan();
             }
+            planned = false;
             critter.move(); // Move one square, possibly hit u
             critter.process_triggers();
             m.creature_in_field( critter );
@@ -4367,6 +4434,27 @@ void game::monmove()
                 u.wake_up();
             }
         }
+    };
+
+    // Not dependent on the number of threads, so that a seeded game plays the same everywhere
+    if( parallel_monster_planning ) {
+        // Everyone thinks first, then moves one after another in the usual order
+        for( monster &critter : all_monsters() ) {
+            start_turn( critter );
+        }
+        std::unordered_set<const monster *> planned;
+        {
+            CATA_PROFILE_ZONE( "monster planning" );
+            planned = plan_monsters_in_parallel( *this );
+        }
+        for( monster &critter : all_monsters() ) {
+            act( critter, planned.count( &critter ) > 0 );
+        }
+    } else {
+        for( monster &critter : all_monsters() ) {
+            start_turn( critter );
+            act( critter, false );
+        }
     }
 
     cleanup_dead();
@@ -4429,6 +4517,7 @@ void game::monmove()
 
 void game::overmap_npc_move()
 {
+    CATA_PROFILE_ZONE( "game::overmap_npc_move" );
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
     for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
@@ -9057,12 +9146,13 @@ std::vector<std::string> game::get_dangerous_tile( const tripoint &dest_loc ) co
             return u.immune_to( bp, { DT_CUT, 10 } );
         };
 
-        if( m.has_flag( "ROUGH", dest_loc ) && !m.has_flag( "ROUGH", u.pos() ) && !boardable &&
+        if( m.has_flag( TFLAG_ROUGH, dest_loc ) && !m.has_flag( TFLAG_ROUGH, u.pos() ) &&
+            !boardable &&
             ( u.get_armor_bash( bodypart_id( "foot_l" ) ) < 5 ||
               u.get_armor_bash( bodypart_id( "foot_r" ) ) < 5 ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
-        } else if( m.has_flag( "SHARP", dest_loc ) && !m.has_flag( "SHARP", u.pos() ) && !( u.in_vehicle ||
-                   g->m.veh_at( dest_loc ) ) &&
+        } else if( m.has_flag( TFLAG_SHARP, dest_loc ) && !m.has_flag( TFLAG_SHARP, u.pos() ) &&
+                   !( u.in_vehicle || g->m.veh_at( dest_loc ) ) &&
                    u.dex_cur < 78 && !std::all_of( sharp_bps.begin(), sharp_bps.end(), sharp_bp_check ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
         }
@@ -9226,11 +9316,11 @@ bool game::walk_move( const tripoint &dest_loc )
     if( u.is_mounted() ) {
         auto crit = u.mounted_creature.get();
         if( !crit->has_flag( MF_RIDEABLE_MECH ) &&
-            ( m.has_flag_ter_or_furn( "MOUNTABLE", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR", dest_loc ) ||
-              m.has_flag_ter_or_furn( "OPENCLOSE_INSIDE", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR_DAMAGED", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR_REINFORCED", dest_loc ) ) ) {
+            ( m.has_flag_ter_or_furn( flag_MOUNTABLE, dest_loc ) ||
+              m.has_flag_ter_or_furn( flag_BARRICADABLE_DOOR, dest_loc ) ||
+              m.has_flag_ter_or_furn( flag_OPENCLOSE_INSIDE, dest_loc ) ||
+              m.has_flag_ter_or_furn( flag_BARRICADABLE_DOOR_DAMAGED, dest_loc ) ||
+              m.has_flag_ter_or_furn( flag_BARRICADABLE_DOOR_REINFORCED, dest_loc ) ) ) {
             add_msg( m_warning, _( "You cannot pass obstacles whilst mounted." ) );
             return false;
         }
@@ -9266,8 +9356,8 @@ bool game::walk_move( const tripoint &dest_loc )
 
     // Print a message if movement is slow
     const int mcost_to = m.move_cost( dest_loc ); //calculate this _after_ calling grabbed_move
-    const bool fungus = m.has_flag_ter_or_furn( "FUNGUS", u.pos() ) ||
-                        m.has_flag_ter_or_furn( "FUNGUS",
+    const bool fungus = m.has_flag_ter_or_furn( flag_FUNGUS, u.pos() ) ||
+                        m.has_flag_ter_or_furn( flag_FUNGUS,
                                 dest_loc ); //fungal furniture has no slowing effect on mycus characters
     const bool slowed = ( ( !u.has_trait( trait_PARKOUR ) && ( mcost_to > 2 || mcost_from > 2 ) ) ||
                           mcost_to > 4 || mcost_from > 4 ) &&
@@ -9304,7 +9394,7 @@ bool game::walk_move( const tripoint &dest_loc )
         ///\EFFECT_DEX decreases chance of tentacles getting stuck to the ground
 
         ///\EFFECT_INT decreases chance of tentacles getting stuck to the ground
-        if( !m.has_flag( "SWIMMABLE", dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
+        if( !m.has_flag( TFLAG_SWIMMABLE, dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
             add_msg( _( "Your tentacles stick to the ground, but you pull them free." ) );
             u.mod_fatigue( 1 );
         }
@@ -9415,22 +9505,22 @@ point game::place_player( const tripoint &dest_loc )
         }
     }
     // TODO: Move the stuff below to a Character method so that NPCs can reuse it
-    if( m.has_flag( "ROUGH", dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
+    if( m.has_flag( TFLAG_ROUGH, dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_l" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your left foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( TFLAG_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_r" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your right foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( TFLAG_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
     }
     ///\EFFECT_DEX increases chance of avoiding cuts on sharp terrain
-    if( m.has_flag( "SHARP", dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
+    if( m.has_flag( TFLAG_SHARP, dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
         ( !u.in_vehicle && !g->m.veh_at( dest_loc ) ) && ( !u.has_trait( trait_PARKOUR ) ||
                 one_in( 4 ) ) && ( u.has_trait( trait_THICKSKIN ) ? !one_in( 8 ) : true ) ) {
         if( u.is_mounted() ) {
@@ -10999,6 +11089,14 @@ point game::update_map( int &x, int &y )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    // Movement tends to keep shifting the map the same way, start reading what comes next.
+    // A tile per turn is about 2 mph, so fast vehicles cross several submaps every turn.
+    int lookahead = 1;
+    if( const vehicle *veh = veh_pointer_or_null( m.veh_at( u.pos() ) ) ) {
+        lookahead = clamp( 1 + std::abs( veh->velocity ) / 2400, 1, 4 );
+    }
+    m.prefetch_submaps( point( sgn( shift.x ), sgn( shift.y ) ), lookahead );
+
     return shift;
 }
 
@@ -12168,6 +12266,31 @@ std::vector<Creature *> game::get_creatures_if( const std::function<bool( const
     return result;
 }
 
+std::vector<Creature *> game::get_creatures_in_radius_if( const tripoint &center, int radius,
+        int radiusz, const std::function<bool( const Creature & )> &pred )
+{
+    const auto in_range = [&]( const Creature & critter ) {
+        const tripoint &p = critter.pos();
+        return std::abs( p.x - center.x ) <= radius && std::abs( p.y - center.y ) <= radius &&
+               std::abs( p.z - center.z ) <= radiusz;
+    };
+    std::vector<Creature *> result;
+    for( monster *critter : critter_tracker->find_in_radius( center, radius, radiusz ) ) {
+        if( pred( *critter ) ) {
+            result.push_back( critter );
+        }
+    }
+    for( npc &guy : all_npcs() ) {
+        if( in_range( guy ) && pred( guy ) ) {
+            result.push_back( &guy );
+        }
+    }
+    if( in_range( u ) && pred( u ) ) {
+        result.push_back( &u );
+    }
+    return result;
+}
+
 std::vector<npc *> game::get_npcs_if( const std::function<bool( const npc & )> &pred )
 {
     std::vector<npc *> result;
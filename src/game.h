@@ -445,6 +445,14 @@ class game
          */
         std::vector<Creature *> get_creatures_if( const std::function<bool( const Creature & )> &pred );
         std::vector<npc *> get_npcs_if( const std::function<bool( const npc & )> &pred );
+        /**
+         * Same as @ref get_creatures_if, but only checks creatures within @p radius tiles
+         * (square distance) of @p center on the x/y plane and within @p radiusz z-levels.
+         * Monsters are looked up through the spatial index of @ref critter_tracker, so this
+         * is much cheaper than @ref get_creatures_if when the bubble is crowded.
+         */
+        std::vector<Creature *> get_creatures_in_radius_if( const tripoint &center, int radius,
+                int radiusz, const std::function<bool( const Creature & )> &pred );
         /**
          * Returns a creature matching a predicate. Only living (not dead) creatures
          * are checked. Returns `nullptr` if no creature matches the predicate.
@@ -2,9 +2,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <fstream>
-#include <iterator>
 #include <memory>
 #include <sstream> // for throwing errors
 #include <stdexcept>
@@ -38,7 +38,6 @@
 #include "fault.h"
 #include "field_type.h"
 #include "filesystem.h"
-#include "fstream_utils.h"
 #include "flag.h"
 #include "gates.h"
 #include "harvest.h"
@@ -92,6 +91,7 @@
 #include "veh_type.h"
 #include "vehicle_group.h"
 #include "vitamin.h"
+#include "worker_pool.h"
 #include "worldfactory.h"
 
 #if defined(TILES)
@@ -123,24 +123,19 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
     it->second( jo, src, base_path, full_path );
 }
 
-struct DynamicDataLoader::cached_streams {
-    lru_cache<std::string, shared_ptr_fast<std::istringstream>> cache;
+struct DynamicDataLoader::cached_files {
+    lru_cache<std::string, shared_ptr_fast<const std::string>> cache;
 };
 
-shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::string &path )
+shared_ptr_fast<const std::string> DynamicDataLoader::get_cached_file( const std::string &path )
 {
     assert( !finalized && "Cannot open data file after finalization." );
-    assert( stream_cache && "Stream cache is only available during finalization" );
-    shared_ptr_fast<std::istringstream> cached = stream_cache->cache.get( path, nullptr );
-    // Create a new stream if the file is not opened yet, or if some code is still
-    // using the previous stream (in such case, `cached` and `stream_cache` have
-    // two references to the stream, hence the test for > 2).
+    assert( file_cache && "File cache is only available during finalization" );
+    shared_ptr_fast<const std::string> cached = file_cache->cache.get( path, nullptr );
     if( !cached ) {
-        cached = make_shared_fast<std::istringstream>( read_entire_file( path ) );
-    } else if( cached.use_count() > 2 ) {
-        cached = make_shared_fast<std::istringstream>( cached->str() );
+        cached = make_shared_fast<const std::string>( read_entire_file( path ) );
     }
-    stream_cache->cache.insert( 8, path, cached );
+    file_cache->cache.insert( 8, path, cached );
     return cached;
 }
 
@@ -154,8 +149,8 @@ void DynamicDataLoader::load_deferred( deferred_json &data )
                 debugmsg( "JSON source location has null path, data may load incorrectly" );
             } else {
                 try {
-                    shared_ptr_fast<std::istream> stream = get_cached_stream( *it->first.path );
-                    JsonIn jsin( *stream, it->first );
+                    shared_ptr_fast<const std::string> text = get_cached_file( *it->first.path );
+                    JsonIn jsin( *text, it->first );
                     JsonObject jo = jsin.get_object();
                     load_object( jo, it->second );
                 } catch( const JsonError &err ) {
@@ -171,8 +166,8 @@ void DynamicDataLoader::load_deferred( deferred_json &data )
                     debugmsg( "JSON source location has null path when reporting circular dependency" );
                 } else {
                     try {
-                        shared_ptr_fast<std::istream> stream = get_cached_stream( *it->first.path );
-                        JsonIn jsin( *stream, elem.first );
+                        shared_ptr_fast<const std::string> text = get_cached_file( *it->first.path );
+                        JsonIn jsin( *text, elem.first );
                         jsin.error( "JSON contains circular dependency, this object is discarded" );
                     } catch( const JsonError &err ) {
                         debugmsg( "(json-error)\n%s", err.what() );
@@ -446,8 +441,49 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+// A data file split into its top level objects, ready to be loaded
+struct parsed_data_file {
+    std::string text;
+    std::unique_ptr<JsonIn> jsin;
+    // Not a vector: destroying the moved-from objects on growth would rewind jsin
+    std::deque<JsonObject> objects;
+    // Error found after the objects, reported once they are loaded
+    std::string error;
+};
+} // namespace
+
+static void parse_data_file( const std::string &file, parsed_data_file &parsed )
+{
+    parsed.text = read_entire_file( file );
+    parsed.jsin = std::make_unique<JsonIn>( parsed.text, file );
+    JsonIn &jsin = *parsed.jsin;
+    try {
+        // TEMPORARY until 0.G: Remove single object support for consistency
+        if( jsin.test_object() ) {
+            parsed.objects.emplace_back( jsin );
+            // if there's anything else in the file, it's an error.
+            jsin.eat_whitespace();
+            if( jsin.good() ) {
+                jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+            }
+        } else if( jsin.test_array() ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                parsed.objects.emplace_back( jsin );
+            }
+        } else {
+            // not an object or an array?
+            jsin.error( "expected object or array" );
+        }
+    } catch( const JsonError &err ) {
+        parsed.error = err.what();
+    }
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+        loading_ui & )
 {
     assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -466,53 +502,24 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss, file );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
-    }
-}
-
-void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
-        const std::string &base_path, const std::string &full_path )
-{
-    // TEMPORARY until 0.G: Remove single object support for consistency
-    if( jsin.test_object() ) {
-        // find type and dispatch single object
-        JsonObject jo = jsin.get_object();
-        load_object( jo, src, base_path, full_path );
-        jo.finish();
-        // if there's anything else in the file, it's an error.
-        jsin.eat_whitespace();
-        if( jsin.good() ) {
-            jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+    // Reading and splitting files into objects doesn't depend on anything loaded, so it happens
+    // on the worker pool. The objects are loaded in order afterwards, as if read one by one.
+    std::vector<parsed_data_file> parsed( files.size() );
+    get_worker_pool().run( files.size(), [&]( const size_t i ) {
+        parse_data_file( files[i], parsed[i] );
+    } );
+    for( size_t i = 0; i < files.size(); ++i ) {
+        for( JsonObject &jo : parsed[i].objects ) {
+            try {
+                load_object( jo, src, path, files[i] );
+                jo.finish();
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( err.what() );
+            }
         }
-    } else if( jsin.test_array() ) {
-        jsin.start_array();
-        // find type and dispatch each object until array close
-        while( !jsin.end_array() ) {
-            JsonObject jo = jsin.get_object();
-            load_object( jo, src, base_path, full_path );
-            jo.finish();
+        if( !parsed[i].error.empty() ) {
+            throw std::runtime_error( parsed[i].error );
         }
-    } else {
-        // not an object or an array?
-        jsin.error( "expected object or array" );
     }
 }
 
@@ -623,12 +630,12 @@ void DynamicDataLoader::finalize_loaded_data()
 void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 {
     assert( !finalized && "Can't finalize the data twice." );
-    assert( !stream_cache && "Expected stream cache to be null before finalization" );
+    assert( !file_cache && "Expected file cache to be null before finalization" );
 
-    on_out_of_scope reset_stream_cache( [this]() {
-        stream_cache.reset();
+    on_out_of_scope reset_file_cache( [this]() {
+        file_cache.reset();
     } );
-    stream_cache = std::make_unique<cached_streams>();
+    file_cache = std::make_unique<cached_files>();
 
     ui.new_context( _( "Finalizing" ) );
 
@@ -14,7 +14,6 @@
 
 class loading_ui;
 class JsonObject;
-class JsonIn;
 
 /**
  * This class is used to load (and unload) the dynamic
@@ -69,8 +68,8 @@ class DynamicDataLoader
     private:
         bool finalized = false;
 
-        struct cached_streams;
-        std::unique_ptr<cached_streams> stream_cache;
+        struct cached_files;
+        std::unique_ptr<cached_files> file_cache;
 
     protected:
         /**
@@ -84,17 +83,6 @@ class DynamicDataLoader
         void add( const std::string &type,
                   std::function<void( const JsonObject &, const std::string &, const std::string &, const std::string & )>
                   f );
-        /**
-         * Load all the types from that json data.
-         * @param jsin Might contain single object,
-         * or an array of objects. Each object must have a
-         * "type", that is part of the @ref type_function_map
-         * @param src String identifier for mod this data comes from
-         * @param ui Finalization status display.
-         * @throws std::exception on all kind of errors.
-         */
-        void load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &ui,
-                                 const std::string &base_path, const std::string &full_path );
         /**
          * Load a single object from a json object.
          * @param jo The json object to load the C++-object from.
@@ -129,6 +117,8 @@ class DynamicDataLoader
          * @param path Either a folder (recursively load all
          * files with the extension .json), or a file (load only
          * that file, don't check extension).
+         * The files are read and parsed on the worker pool, their objects are
+         * then loaded in file order on the calling thread.
          * @param src String identifier for mod this data comes from
          * @param ui Finalization status display.
          * @throws std::exception on all kind of errors.
@@ -169,12 +159,10 @@ class DynamicDataLoader
         }
 
         /**
-         * Get a possibly cached stream for deferred data loading. If the cached
-         * stream is still in use by outside code, this returns a new stream to
-         * avoid conflict of stream cursor. The stream cursor is not reset if a
-         * cached stream is returned.
+         * Get the possibly cached contents of a data file for deferred data loading.
+         * The text is never modified, any number of @ref JsonIn can parse it at once.
          */
-        shared_ptr_fast<std::istream> get_cached_stream( const std::string &path );
+        shared_ptr_fast<const std::string> get_cached_file( const std::string &path );
 };
 
 #endif // CATA_SRC_INIT_H
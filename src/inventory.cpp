@@ -121,6 +121,27 @@ invlet_favorites::get_invlets_by_id() const
 
 inventory::inventory() = default;
 
+// The caches point into the stacks, a copy has to build its own
+inventory::inventory( const inventory &rhs )
+    : assigned_invlet( rhs.assigned_invlet )
+    , invlet_cache( rhs.invlet_cache )
+    , items( rhs.items )
+{
+}
+
+inventory &inventory::operator=( const inventory &rhs )
+{
+    if( this != &rhs ) {
+        assigned_invlet = rhs.assigned_invlet;
+        invlet_cache = rhs.invlet_cache;
+        items = rhs.items;
+        binned = false;
+        stacks_indexed = false;
+        formed_from_map = false;
+    }
+    return *this;
+}
+
 invslice inventory::slice()
 {
     invslice stacks;
@@ -217,6 +238,7 @@ inventory inventory::operator+ ( const item &rhs )
 void inventory::unsort()
 {
     binned = false;
+    stacks_indexed = false;
 }
 
 static bool stack_compare( const std::list<item> &lhs, const std::list<item> &rhs )
@@ -228,6 +250,8 @@ void inventory::clear()
 {
     items.clear();
     binned = false;
+    stacks_indexed = false;
+    formed_from_map = false;
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -271,17 +295,41 @@ char inventory::find_usable_cached_invlet( const std::string &item_type )
     return 0;
 }
 
+void inventory::index_stacks()
+{
+    stacks_by_type.clear();
+    for( std::list<item> &elem : items ) {
+        stacks_by_type[elem.front().typeId()].push_back( &elem );
+    }
+    stacks_indexed = true;
+}
+
 item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, bool should_stack )
 {
-    binned = false;
+    if( !formed_from_map ) {
+        binned = false;
+        stacks_indexed = false;
+    } else if( !stacks_indexed ) {
+        index_stacks();
+    }
+    // Keeps the bins valid, merged charges don't change which items there are
+    const auto bin_new_item = [this]( item & added ) -> item & {
+        if( binned ) {
+            added.visit_items( [this]( item * e ) {
+                binned_items[e->typeId()].push_back( e );
+                return VisitResponse::NEXT;
+            } );
+        }
+        return added;
+    };
 
     if( should_stack ) {
         // See if we can't stack this item.
-        for( auto &elem : items ) {
+        const auto try_stack = [&]( std::list<item> &elem ) -> item * {
             std::list<item>::iterator it_ref = elem.begin();
             if( it_ref->stacks_with( newit ) ) {
                 if( it_ref->merge_charges( newit ) ) {
-                    return *it_ref;
+                    return &*it_ref;
                 }
                 if( it_ref->invlet == '\0' ) {
                     if( !keep_invlet ) {
@@ -293,11 +341,29 @@ item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, boo
                     newit.invlet = it_ref->invlet;
                 }
                 elem.push_back( newit );
-                return elem.back();
+                return &bin_new_item( elem.back() );
             } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
                 // If keep_invlet is true, we'll be forcing other items out of their current invlet.
                 assign_empty_invlet( *it_ref, g->u );
             }
+            return nullptr;
+        };
+        if( !stacks_indexed || ( keep_invlet && assign_invlet ) ) {
+            // Without the index, or when every stack has to be checked for the invlet
+            for( auto &elem : items ) {
+                if( item *const stacked = try_stack( elem ) ) {
+                    return *stacked;
+                }
+            }
+        } else {
+            const auto candidates = stacks_by_type.find( newit.typeId() );
+            if( candidates != stacks_by_type.end() ) {
+                for( std::list<item> *elem : candidates->second ) {
+                    if( item *const stacked = try_stack( *elem ) ) {
+                        return *stacked;
+                    }
+                }
+            }
         }
     }
 
@@ -310,7 +376,10 @@ item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, boo
     std::list<item> newstack;
     newstack.push_back( newit );
     items.push_back( newstack );
-    return items.back().back();
+    if( stacks_indexed ) {
+        stacks_by_type[newit.typeId()].push_back( &items.back() );
+    }
+    return bin_new_item( items.back().back() );
 }
 
 void inventory::add_item_keep_invlet( item newit )
@@ -335,6 +404,7 @@ void inventory::restack( player &p )
     // 3. combine matching stacks
 
     binned = false;
+    stacks_indexed = false;
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -440,7 +510,8 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
                                bool assign_invlet )
 {
     const time_point bday = calendar::start_of_cataclysm;
-    items.clear();
+    clear();
+    formed_from_map = true;
     for( const tripoint &p : pts ) {
         if( m.has_furn( p ) ) {
             const furn_t &f = m.furn( p ).obj();
@@ -617,6 +688,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            stacks_indexed = false;
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -639,6 +711,7 @@ item inventory::remove_item( const item *it )
     }, 1 );
     if( !tmp.empty() ) {
         binned = false;
+        stacks_indexed = false;
         return tmp.front();
     }
     debugmsg( "Tried to remove a item not in inventory." );
@@ -651,6 +724,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            stacks_indexed = false;
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -696,6 +770,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            stacks_indexed = false;
             items.erase( chosen_stack );
         }
     }
@@ -783,6 +858,7 @@ std::list<item> inventory::use_amount( itype_id it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            stacks_indexed = false;
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
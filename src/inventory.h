@@ -97,9 +97,9 @@ class inventory : public visitable<inventory>
 
         inventory();
         inventory( inventory && ) = default;
-        inventory( const inventory & ) = default;
+        inventory( const inventory &rhs );
         inventory &operator=( inventory && ) = default;
-        inventory &operator=( const inventory & ) = default;
+        inventory &operator=( const inventory &rhs );
 
         inventory &operator+= ( const inventory &rhs );
         inventory &operator+= ( const item &rhs );
@@ -231,6 +231,8 @@ class inventory : public visitable<inventory>
         enchantment get_active_enchantment_cache( const Character &owner ) const;
 
     private:
+        void index_stacks();
+
         invlet_favorites invlet_cache;
         char find_usable_cached_invlet( const std::string &item_type );
 
@@ -243,6 +245,20 @@ class inventory : public visitable<inventory>
          * `mutable` because this is a pure cache that doesn't affect the contained items.
          */
         mutable itype_bin binned_items;
+
+        /**
+         * Set by @ref form_from_map until the next @ref clear. Only such inventories, which hold
+         * copies nobody transforms in place, have @ref add_item keep the bins and the stack
+         * index up to date. Everywhere else adding drops both, since items like the ones in
+         * Character::inv change their type without the inventory noticing.
+         */
+        bool formed_from_map = false;
+        bool stacks_indexed = false;
+        /**
+         * Stacks by the type of their items, so that @ref add_item only compares a new item
+         * with stacks it could join. Rebuilt after anything but @ref add_item changed the stacks.
+         */
+        std::unordered_map<itype_id, std::vector<std::list<item> *>> stacks_by_type;
 };
 
 #endif // CATA_SRC_INVENTORY_H
@@ -60,6 +60,7 @@
 #include "line.h"
 #include "magic.h"
 #include "map.h"
+#include "mapdata.h"
 #include "martialarts.h"
 #include "material.h"
 #include "messages.h"
@@ -142,44 +143,40 @@ static const std::string flag_AURA( "AURA" );
 static const std::string flag_BELTED( "BELTED" );
 static const std::string flag_BIPOD( "BIPOD" );
 static const std::string flag_BYPRODUCT( "BYPRODUCT" );
-static const std::string flag_CABLE_SPOOL( "CABLE_SPOOL" );
+static const flag_str_id flag_CABLE_SPOOL( "CABLE_SPOOL" );
 static const std::string flag_CANNIBALISM( "CANNIBALISM" );
-static const std::string flag_CHARGEDIM( "CHARGEDIM" );
+static const flag_str_id flag_CHARGEDIM( "CHARGEDIM" );
 static const std::string flag_COLLAPSIBLE_STOCK( "COLLAPSIBLE_STOCK" );
 static const std::string flag_CONDUCTIVE( "CONDUCTIVE" );
 static const std::string flag_CONSUMABLE( "CONSUMABLE" );
 static const std::string flag_CORPSE( "CORPSE" );
 static const std::string flag_DANGEROUS( "DANGEROUS" );
-static const std::string flag_DEEP_WATER( "DEEP_WATER" );
 static const std::string flag_DIAMOND( "DIAMOND" );
 static const std::string flag_DISABLE_SIGHTS( "DISABLE_SIGHTS" );
-static const std::string flag_ETHEREAL_ITEM( "ETHEREAL_ITEM" );
-static const std::string flag_FAKE_MILL( "FAKE_MILL" );
-static const std::string flag_FAKE_SMOKE( "FAKE_SMOKE" );
+static const flag_str_id flag_ETHEREAL_ITEM( "ETHEREAL_ITEM" );
+static const flag_str_id flag_FAKE_MILL( "FAKE_MILL" );
+static const flag_str_id flag_FAKE_SMOKE( "FAKE_SMOKE" );
 static const std::string flag_FIELD_DRESS( "FIELD_DRESS" );
 static const std::string flag_FIELD_DRESS_FAILED( "FIELD_DRESS_FAILED" );
-static const std::string flag_FILTHY( "FILTHY" );
+static const flag_str_id flag_FILTHY( "FILTHY" );
 static const std::string flag_FIRE_100( "FIRE_100" );
 static const std::string flag_FIRE_20( "FIRE_20" );
 static const std::string flag_FIRE_50( "FIRE_50" );
 static const std::string flag_FIRE_TWOHAND( "FIRE_TWOHAND" );
 static const std::string flag_FIT( "FIT" );
-static const std::string flag_FLAMMABLE( "FLAMMABLE" );
-static const std::string flag_FLAMMABLE_ASH( "FLAMMABLE_ASH" );
 static const std::string flag_GIBBED( "GIBBED" );
 static const std::string flag_HEATS_FOOD( "HEATS_FOOD" );
 static const std::string flag_HELMET_COMPAT( "HELMET_COMPAT" );
 static const std::string flag_HIDDEN_HALLU( "HIDDEN_HALLU" );
 static const std::string flag_HIDDEN_POISON( "HIDDEN_POISON" );
-static const std::string flag_IRREMOVABLE( "IRREMOVABLE" );
+static const flag_str_id flag_IRREMOVABLE( "IRREMOVABLE" );
 static const std::string flag_IS_ARMOR( "IS_ARMOR" );
 static const std::string flag_IS_PET_ARMOR( "IS_PET_ARMOR" );
-static const std::string flag_IS_UPS( "IS_UPS" );
+static const flag_str_id flag_IS_UPS( "IS_UPS" );
 static const std::string flag_LEAK_ALWAYS( "LEAK_ALWAYS" );
 static const std::string flag_LEAK_DAM( "LEAK_DAM" );
-static const std::string flag_LIQUID( "LIQUID" );
 static const std::string flag_LIQUIDCONT( "LIQUIDCONT" );
-static const std::string flag_LITCIG( "LITCIG" );
+static const flag_str_id flag_LITCIG( "LITCIG" );
 static const std::string flag_MAG_BELT( "MAG_BELT" );
 static const std::string flag_MAG_DESTROY( "MAG_DESTROY" );
 static const std::string flag_MAG_EJECT( "MAG_EJECT" );
@@ -209,10 +206,10 @@ static const std::string flag_RADIOACTIVE( "RADIOACTIVE" );
 static const std::string flag_RADIOSIGNAL_1( "RADIOSIGNAL_1" );
 static const std::string flag_RADIOSIGNAL_2( "RADIOSIGNAL_2" );
 static const std::string flag_RADIOSIGNAL_3( "RADIOSIGNAL_3" );
-static const std::string flag_RADIO_ACTIVATION( "RADIO_ACTIVATION" );
+static const flag_str_id flag_RADIO_ACTIVATION( "RADIO_ACTIVATION" );
 static const std::string flag_RADIO_INVOKE_PROC( "RADIO_INVOKE_PROC" );
 static const std::string flag_RADIO_MOD( "RADIO_MOD" );
-static const std::string flag_RAIN_PROTECT( "RAIN_PROTECT" );
+static const flag_str_id flag_RAIN_PROTECT( "RAIN_PROTECT" );
 static const std::string flag_REACH3( "REACH3" );
 static const std::string flag_REACH_ATTACK( "REACH_ATTACK" );
 static const std::string flag_RECHARGE( "RECHARGE" );
@@ -229,18 +226,18 @@ static const std::string flag_SLOW_WIELD( "SLOW_WIELD" );
 static const std::string flag_SPEEDLOADER( "SPEEDLOADER" );
 static const std::string flag_SPLINT( "SPLINT" );
 static const std::string flag_STR_DRAW( "STR_DRAW" );
-static const std::string flag_TOBACCO( "TOBACCO" );
+static const flag_str_id flag_TOBACCO( "TOBACCO" );
 static const std::string flag_UNARMED_WEAPON( "UNARMED_WEAPON" );
 static const std::string flag_UNDERSIZE( "UNDERSIZE" );
 static const std::string flag_USES_BIONIC_POWER( "USES_BIONIC_POWER" );
-static const std::string flag_USE_UPS( "USE_UPS" );
+static const flag_str_id flag_USE_UPS( "USE_UPS" );
 static const std::string flag_VARSIZE( "VARSIZE" );
 static const std::string flag_VEHICLE( "VEHICLE" );
 static const std::string flag_WAIST( "WAIST" );
 static const std::string flag_WATERPROOF_GUN( "WATERPROOF_GUN" );
-static const std::string flag_WATER_EXTINGUISH( "WATER_EXTINGUISH" );
-static const std::string flag_WET( "WET" );
-static const std::string flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
+static const flag_str_id flag_WATER_EXTINGUISH( "WATER_EXTINGUISH" );
+static const flag_str_id flag_WET( "WET" );
+static const flag_str_id flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
 
 static const matec_id rapid_strike( "RAPID" );
 
@@ -4954,9 +4951,24 @@ bool item::has_own_flag( const std::string &f ) const
 
 bool item::has_flag( const std::string &f ) const
 {
-    bool ret = false;
+    const flag_id id = json_flag::find( f );
+    if( id.is_valid() ) {
+        return has_flag( id );
+    }
 
-    if( json_flag::get( f ).inherit() ) {
+    // flags missing from JSON are always inherited
+    for( const item *e : is_gun() ? gunmods() : toolmods() ) {
+        if( !e->is_gun() && e->has_flag( f ) ) {
+            return true;
+        }
+    }
+    return type->has_flag( f ) || has_own_flag( f );
+}
+
+bool item::has_flag( const flag_id &f ) const
+{
+    // Attached mods are in the contents, skip collecting them when there are none
+    if( f->inherit() && !contents.empty() ) {
         for( const item *e : is_gun() ? gunmods() : toolmods() ) {
             // gunmods fired separately do not contribute to base gun flags
             if( !e->is_gun() && e->has_flag( f ) ) {
@@ -4966,14 +4978,17 @@ bool item::has_flag( const std::string &f ) const
     }
 
     // other item type flags
-    ret = type->has_flag( f );
-    if( ret ) {
-        return ret;
+    if( type->has_flag( f ) ) {
+        return true;
     }
 
     // now check for item specific flags
-    ret = has_own_flag( f );
-    return ret;
+    return has_own_flag( f.id().str() );
+}
+
+bool item::has_flag( const flag_str_id &f ) const
+{
+    return f.is_valid() ? has_flag( f.id() ) : has_flag( f.str() );
 }
 
 item &item::set_flag( const std::string &flag )
@@ -8513,24 +8528,23 @@ bool item::process_rot( float /*insulation*/, const bool seals,
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = g->weather.get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
         int local_mod = g->new_game ? 0 : g->m.get_temperature( pos );
 
         if( carried ) {
             local_mod += 5; // body heat increases inventory temperature
         }
 
-        // Process the past of this item since the last time it was processed
-        while( now - time > 1_hours ) {
-            // Get the environment temperature
-            time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
-            time += time_delta;
+        // Process the past of this item since the last time it was processed.
+        // The steps end on whole hours, so everything stored at the same place shares
+        // the weather lookups, the rest of the last hour is handled below.
+        for( time_point hour = time + 1_hours - ( time - calendar::turn_zero ) % 1_hours;
+             now - hour >= 1_hours; hour += 1_hours ) {
+            time = hour;
 
             //Use weather if above ground, use map temp if below
             double env_temperature = 0;
             if( pos.z >= 0 ) {
-                double weather_temperature = wgen.get_weather_temperature( pos, time, seed );
+                double weather_temperature = g->weather.get_weather_temperature( pos, time );
                 env_temperature = weather_temperature + local_mod;
             } else {
                 env_temperature = AVERAGE_ANNUAL_TEMPERATURE + local_mod;
@@ -8566,7 +8580,7 @@ bool item::process_rot( float /*insulation*/, const bool seals,
         }
     }
 
-    // Remaining <1 h from above
+    // Remaining <2 h from above
     // and items that are held near the player
     if( now - time > smallest_interval ) {
         calc_rot( now, temp );
@@ -8747,8 +8761,8 @@ bool item::process_litcig( player *carrier, const tripoint &pos )
         if( item_counter % 5 == 0 ) {
             // lit cigarette can start fires
             if( g->m.flammable_items_at( pos ) ||
-                g->m.has_flag( flag_FLAMMABLE, pos ) ||
-                g->m.has_flag( flag_FLAMMABLE_ASH, pos ) ) {
+                g->m.has_flag( TFLAG_FLAMMABLE, pos ) ||
+                g->m.has_flag( TFLAG_FLAMMABLE_ASH, pos ) ) {
                 g->m.add_field( pos, fd_fire, 1 );
             }
         }
@@ -8808,11 +8822,11 @@ bool item::process_extinguish( player *carrier, const tripoint &pos )
         default:
             break;
     }
-    if( in_inv && !in_veh && g->m.has_flag( flag_DEEP_WATER, pos ) ) {
+    if( in_inv && !in_veh && g->m.has_flag( TFLAG_DEEP_WATER, pos ) ) {
         extinguish = true;
         submerged = true;
     }
-    if( ( !in_inv && g->m.has_flag( flag_LIQUID, pos ) && !g->m.veh_at( pos ) ) ||
+    if( ( !in_inv && g->m.has_flag( TFLAG_LIQUID, pos ) && !g->m.veh_at( pos ) ) ||
         ( precipitation && !g->is_sheltered( pos ) ) ) {
         extinguish = true;
     }
@@ -1372,6 +1372,13 @@ class item : public visitable<item>
          */
         /*@{*/
         bool has_flag( const std::string &flag ) const;
+        /** Same as above for a flag defined in JSON, skips looking up its name. */
+        bool has_flag( const flag_id &flag ) const;
+        /**
+         * Same as above, for the static flag ids of callers that check a flag often. The id
+         * remembers its flag_id, flags missing from JSON fall back to the string version.
+         */
+        bool has_flag( const flag_str_id &flag ) const;
 
         template<typename Container, typename T = std::decay_t<decltype( *std::declval<const Container &>().begin() )>>
         bool has_any_flag( const Container &flags ) const {
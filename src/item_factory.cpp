@@ -525,6 +525,10 @@ void Item_factory::finalize_post( itype &obj )
             return false;
         }
     } );
+    obj.flag_bits.assign( json_flag::count(), false );
+    for( const std::string &f : obj.item_tags ) {
+        obj.flag_bits[json_flag::find( f ).to_i()] = true;
+    }
 
     // handle complex firearms as a special case
     if( obj.gun && !obj.has_flag( "PRIMITIVE_RANGED_WEAPON" ) ) {
@@ -3,6 +3,7 @@
 #include <cstdlib>
 
 #include "debug.h"
+#include "flag.h"
 #include "item.h"
 #include "player.h"
 #include "ret_val.h"
@@ -70,7 +71,16 @@ bool itype::has_use() const
 
 bool itype::has_flag( const std::string &flag ) const
 {
-    return item_tags.count( flag );
+    const flag_id id = json_flag::find( flag );
+    return id.is_valid() ? has_flag( id ) : item_tags.count( flag ) > 0;
+}
+
+bool itype::has_flag( const flag_id &flag ) const
+{
+    if( flag_bits.empty() ) {
+        return flag.is_valid() && item_tags.count( flag.id().str() ) > 0;
+    }
+    return static_cast<size_t>( flag.to_i() ) < flag_bits.size() && flag_bits[flag.to_i()];
 }
 
 const itype::FlagsSetType &itype::get_flags() const
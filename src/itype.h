@@ -863,6 +863,9 @@ struct itype {
         int damage_max_ = +4000;
         /// @}
 
+        /** @ref item_tags as bits indexed by @ref flag_id, filled in when the type is finalized. */
+        std::vector<bool> flag_bits;
+
     protected:
         std::string id = "null"; /** unique string identifier for this type */
 
@@ -1101,6 +1104,8 @@ struct itype {
         bool has_use() const;
 
         bool has_flag( const std::string &flag ) const;
+        /** Same as above, but only tests a bit once the type is finalized. */
+        bool has_flag( const flag_id &flag ) const;
 
         // returns read-only set of all item tags/flags
         const FlagsSetType &get_flags() const;
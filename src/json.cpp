@@ -86,20 +86,41 @@ JsonObject::JsonObject( JsonIn &j )
     while( !jsin->end_object() ) {
         std::string n = jsin->get_member_name();
         int p = jsin->tell();
-        if( positions.count( n ) > 0 ) {
+        const auto iter = lower_bound( n );
+        if( iter != members.end() && iter->name == n ) {
             j.error( "duplicate entry in json object" );
         }
-        positions[n] = p;
+        members.insert( iter, member_position{ std::move( n ), p, false } );
         jsin->skip_value();
     }
     end_ = jsin->tell();
     final_separator = jsin->get_ate_separator();
 }
 
+std::vector<JsonObject::member_position>::const_iterator JsonObject::lower_bound(
+    const std::string &name ) const
+{
+    return std::lower_bound( members.begin(), members.end(), name,
+    []( const member_position & member, const std::string & target ) {
+        return member.name < target;
+    } );
+}
+
+const JsonObject::member_position *JsonObject::find_member( const std::string &name ) const
+{
+    const auto iter = lower_bound( name );
+    if( iter == members.end() || iter->name != name ) {
+        return nullptr;
+    }
+    return &*iter;
+}
+
 void JsonObject::mark_visited( const std::string &name ) const
 {
 #ifndef CATA_IN_TOOL
-    visited_members.emplace( name );
+    if( const member_position *member = find_member( name ) ) {
+        member->visited = true;
+    }
 #else
     static_cast<void>( name );
 #endif
@@ -115,9 +136,9 @@ void JsonObject::report_unvisited() const
         && !std::uncaught_exception()
     ) {
         reported_unvisited_members = true;
-        for( const std::pair<const std::string, int> &p : positions ) {
-            const std::string &name = p.first;
-            if( !visited_members.count( name ) && !string_starts_with( name, "//" ) ) {
+        for( const member_position &member : members ) {
+            const std::string &name = member.name;
+            if( !member.visited && !string_starts_with( name, "//" ) ) {
                 try {
                     throw_error( string_format( "Invalid or misplaced field name \"%s\" in JSON data", name ), name );
                 } catch( const JsonError &e ) {
@@ -140,11 +161,11 @@ void JsonObject::finish()
 
 size_t JsonObject::size() const
 {
-    return positions.size();
+    return members.size();
 }
 bool JsonObject::empty() const
 {
-    return positions.empty();
+    return members.empty();
 }
 
 void JsonObject::allow_omitted_members() const
@@ -165,8 +186,8 @@ int JsonObject::verify_position( const std::string &name,
         // so it will never indicate a valid member position
         return 0;
     }
-    const auto iter = positions.find( name );
-    if( iter == positions.end() ) {
+    const member_position *member = find_member( name );
+    if( member == nullptr ) {
         if( throw_exception ) {
             jsin->seek( start );
             jsin->error( "member not found: " + name );
@@ -175,12 +196,12 @@ int JsonObject::verify_position( const std::string &name,
         // so it will never indicate a valid member position
         return 0;
     }
-    return iter->second;
+    return member->position;
 }
 
 bool JsonObject::has_member( const std::string &name ) const
 {
-    return positions.count( name ) > 0;
+    return find_member( name ) != nullptr;
 }
 
 std::string JsonObject::line_number() const
@@ -725,37 +746,224 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+JsonIn::JsonIn( std::istream &s )
+{
+    read_source( s );
+}
+
+JsonIn::JsonIn( std::istream &s, const std::string &path )
+    : path( make_shared_fast<std::string>( path ) )
+{
+    read_source( s );
+}
+
+JsonIn::JsonIn( std::istream &s, const json_source_location &loc )
+    : path( loc.path )
+{
+    read_source( s );
+    seek( loc.offset );
+}
+
+JsonIn::JsonIn( const std::string &text, const std::string &path )
+    : text_begin( text.data() ), text_end( text.data() + text.size() ), cur( text.data() ),
+      path( make_shared_fast<std::string>( path ) )
+{
+}
+
+JsonIn::JsonIn( const std::string &text, const json_source_location &loc )
+    : text_begin( text.data() ), text_end( text.data() + text.size() ), cur( text.data() ),
+      path( loc.path )
+{
+    seek( loc.offset );
+}
+
+JsonIn::~JsonIn()
+{
+    if( source == nullptr ) {
+        return;
+    }
+    // Leave the stream as if it had been parsed directly
+    source->clear();
+    source->seekg( cur - text_begin );
+    if( eof_bit ) {
+        source->setstate( std::ios::eofbit );
+    }
+    if( fail_bit ) {
+        source->setstate( std::ios::failbit );
+    }
+}
+
+void JsonIn::read_source( std::istream &s )
+{
+    source = &s;
+    eof_bit = s.eof();
+    fail_bit = s.fail();
+    // Offsets are those of the stream, so the text starts at the beginning of the stream
+    // whenever it can be rewound
+    std::streamoff start = s.tellg();
+    std::streambuf *buf = s.rdbuf();
+    const std::streamoff size = start < 0 ? -1 : std::streamoff( buf->pubseekoff( 0, std::ios::end,
+                                std::ios::in ) );
+    if( size >= 0 && buf->pubseekpos( 0, std::ios::in ) == 0 ) {
+        owned_text.resize( size );
+        owned_text.resize( std::max<std::streamsize>( buf->sgetn( &owned_text[0], size ), 0 ) );
+    } else {
+        start = 0;
+        std::ostringstream contents;
+        contents << buf;
+        owned_text = contents.str();
+    }
+    text_begin = owned_text.data();
+    text_end = text_begin + owned_text.size();
+    cur = text_begin + std::min<std::streamoff>( start, owned_text.size() );
+}
+
+bool JsonIn::sentry()
+{
+    if( eof_bit || fail_bit ) {
+        fail_bit = true;
+        return false;
+    }
+    return true;
+}
+
+int JsonIn::get_char()
+{
+    if( !sentry() ) {
+        return EOF;
+    }
+    if( cur == text_end ) {
+        eof_bit = true;
+        fail_bit = true;
+        return EOF;
+    }
+    return static_cast<unsigned char>( *cur++ );
+}
+
+bool JsonIn::get_char( char &ch )
+{
+    const int c = get_char();
+    if( c == EOF ) {
+        return false;
+    }
+    ch = static_cast<char>( c );
+    return true;
+}
+
+void JsonIn::get_text( char *dest, size_t size )
+{
+    // Like std::istream::get( char *, std::streamsize ), stops before a line break
+    size_t count = 0;
+    if( sentry() ) {
+        while( count + 1 < size ) {
+            if( cur == text_end ) {
+                eof_bit = true;
+                break;
+            }
+            if( *cur == '\n' ) {
+                break;
+            }
+            dest[count++] = *cur++;
+        }
+        if( count == 0 ) {
+            fail_bit = true;
+        }
+    }
+    if( size > 0 ) {
+        dest[count] = '\0';
+    }
+}
+
+void JsonIn::unget_char()
+{
+    eof_bit = false;
+    if( !sentry() ) {
+        return;
+    }
+    if( cur == text_begin ) {
+        fail_bit = true;
+        return;
+    }
+    --cur;
+}
+
+void JsonIn::ignore_char()
+{
+    if( !sentry() ) {
+        return;
+    }
+    if( cur == text_end ) {
+        eof_bit = true;
+        return;
+    }
+    ++cur;
+}
+
+void JsonIn::move_by( int offset )
+{
+    eof_bit = false;
+    if( fail_bit ) {
+        return;
+    }
+    if( offset < text_begin - cur || offset > text_end - cur ) {
+        fail_bit = true;
+        return;
+    }
+    cur += offset;
+}
+
 int JsonIn::tell()
 {
-    return stream->tellg();
+    if( fail_bit ) {
+        return -1;
+    }
+    return cur - text_begin;
 }
 char JsonIn::peek()
 {
-    return static_cast<char>( stream->peek() );
+    if( !sentry() ) {
+        return static_cast<char>( EOF );
+    }
+    if( cur == text_end ) {
+        eof_bit = true;
+        return static_cast<char>( EOF );
+    }
+    return *cur;
 }
 bool JsonIn::good()
 {
-    return stream->good();
+    return !eof_bit && !fail_bit;
 }
 
 void JsonIn::seek( int pos )
 {
-    stream->clear();
-    stream->seekg( pos );
+    eof_bit = false;
+    fail_bit = pos < 0 || pos > text_end - text_begin;
+    if( !fail_bit ) {
+        cur = text_begin + pos;
+    }
     ate_separator = false;
 }
 
 void JsonIn::eat_whitespace()
 {
-    while( is_whitespace( peek() ) ) {
-        stream->get();
+    if( !good() ) {
+        // Only marks the failure
+        peek();
+        return;
+    }
+    while( cur != text_end && is_whitespace( *cur ) ) {
+        ++cur;
+    }
+    if( cur == text_end ) {
+        eof_bit = true;
     }
 }
 
 void JsonIn::uneat_whitespace()
 {
     while( tell() > 0 ) {
-        stream->seekg( -1, std::istream::cur );
+        move_by( -1 );
         if( !is_whitespace( peek() ) ) {
             break;
         }
@@ -783,7 +991,7 @@ void JsonIn::skip_separator()
         if( ate_separator ) {
             error( "duplicate comma" );
         }
-        stream->get();
+        ignore_char();
         ate_separator = true;
     } else if( ch == ']' || ch == '}' || ch == ':' ) {
         // okay
@@ -810,9 +1018,9 @@ void JsonIn::skip_separator()
 
 void JsonIn::skip_pair_separator()
 {
-    char ch;
+    char ch = '\0';
     eat_whitespace();
-    stream->get( ch );
+    get_char( ch );
     if( ch != ':' ) {
         std::stringstream err;
         err << "expected pair separator ':', not '" << ch << "'";
@@ -825,18 +1033,22 @@ void JsonIn::skip_pair_separator()
 
 void JsonIn::skip_string()
 {
-    char ch;
+    char ch = '\0';
     eat_whitespace();
-    stream->get( ch );
+    get_char( ch );
     if( ch != '"' ) {
         std::stringstream err;
         err << "expecting string but found '" << ch << "'";
         error( err.str(), -1 );
     }
-    while( stream->good() ) {
-        stream->get( ch );
+    while( good() ) {
+        // Nothing but these characters matters, skip anything else in one go
+        while( cur != text_end && *cur != '\\' && *cur != '"' && *cur != '\r' && *cur != '\n' ) {
+            ++cur;
+        }
+        get_char( ch );
         if( ch == '\\' ) {
-            stream->get( ch );
+            get_char( ch );
             continue;
         } else if( ch == '"' ) {
             break;
@@ -901,7 +1113,7 @@ void JsonIn::skip_true()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    get_text( text, 5 );
     if( strcmp( text, "true" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "true", but found ")" << text << "\"";
@@ -914,7 +1126,7 @@ void JsonIn::skip_false()
 {
     char text[6];
     eat_whitespace();
-    stream->get( text, 6 );
+    get_text( text, 6 );
     if( strcmp( text, "false" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "false", but found ")" << text << "\"";
@@ -927,7 +1139,7 @@ void JsonIn::skip_null()
 {
     char text[5];
     eat_whitespace();
-    stream->get( text, 5 );
+    get_text( text, 5 );
     if( strcmp( text, "null" ) != 0 ) {
         std::stringstream err;
         err << R"(expected "null", but found ")" << text << "\"";
@@ -938,15 +1150,16 @@ void JsonIn::skip_null()
 
 void JsonIn::skip_number()
 {
-    char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
-    while( stream->good() ) {
-        stream->get( ch );
-        if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
-            ch != 'e' && ch != 'E' && ch != '.' ) {
-            stream->unget();
-            break;
+    if( good() ) {
+        while( cur != text_end && ( *cur == '+' || *cur == '-' || ( *cur >= '0' && *cur <= '9' ) ||
+                                    *cur == 'e' || *cur == 'E' || *cur == '.' ) ) {
+            ++cur;
+        }
+        if( cur == text_end ) {
+            eof_bit = true;
+            fail_bit = true;
         }
     }
     end_value();
@@ -959,22 +1172,22 @@ std::string JsonIn::get_member_name()
     return s;
 }
 
-static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::string &err )
+bool JsonIn::get_escaped_or_unicode( std::string &s, std::string &err )
 {
-    if( !stream.good() ) {
+    if( !good() ) {
         err = "stream not good";
         return false;
     }
     char ch;
-    stream.get( ch );
-    if( !stream.good() ) {
+    get_char( ch );
+    if( !good() ) {
         err = "read operation failed";
         return false;
     }
     if( ch == '\\' ) {
         // converting \", \\, \/, \b, \f, \n, \r, \t and \uxxxx according to JSON spec.
-        stream.get( ch );
-        if( !stream.good() ) {
+        get_char( ch );
+        if( !good() ) {
             err = "read operation failed";
             return false;
         }
@@ -1006,8 +1219,8 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
             case 'u': {
                     uint32_t u = 0;
                     for( int i = 0; i < 4; ++i ) {
-                        stream.get( ch );
-                        if( !stream.good() ) {
+                        get_char( ch );
+                        if( !good() ) {
                             err = "read operation failed";
                             return false;
                         }
@@ -1072,8 +1285,8 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
         }
         s += ch;
         for( ; n > 0; --n ) {
-            stream.get( ch );
-            if( !stream.good() ) {
+            get_char( ch );
+            if( !good() ) {
                 err = "read operation failed";
                 return false;
             }
@@ -1102,8 +1315,8 @@ std::string JsonIn::get_string()
     bool success = false;
     do {
         // the first character had better be a '"'
-        stream->get( ch );
-        if( !stream->good() ) {
+        get_char( ch );
+        if( !good() ) {
             err = "read operation failed";
             break;
         }
@@ -1111,30 +1324,38 @@ std::string JsonIn::get_string()
             err = "expected string but got '" + std::string( 1, ch ) + "'";
             break;
         }
-        // add chars to the string, one at a time
+        // add chars to the string, runs of plain characters at once, anything else one at a time
         do {
-            ch = stream->peek();
-            if( !stream->good() ) {
+            ch = peek();
+            if( !good() ) {
                 err = "read operation failed";
                 break;
             }
             if( ch == '"' ) {
-                stream->ignore();
+                ignore_char();
                 success = true;
                 break;
             }
-            if( !get_escaped_or_unicode( *stream, s, err ) ) {
+            const char *plain_end = cur;
+            while( plain_end != text_end && *plain_end >= 0x20 && *plain_end != '"' &&
+                   *plain_end != '\\' ) {
+                ++plain_end;
+            }
+            if( plain_end != cur ) {
+                s.append( cur, plain_end );
+                cur = plain_end;
+            } else if( !get_escaped_or_unicode( s, err ) ) {
                 break;
             }
-        } while( stream->good() );
+        } while( good() );
     } while( false );
     if( success ) {
         end_value();
         return s;
     }
-    if( stream->eof() ) {
+    if( eof_bit ) {
         error( "couldn't find end of string, reached EOF." );
-    } else if( stream->fail() ) {
+    } else if( fail_bit ) {
         error( "stream failure while reading string." );
     } else {
         error( err, -1 );
@@ -1270,13 +1491,17 @@ double JsonIn::get_float()
 number_sci_notation JsonIn::get_any_number()
 {
     // this could maybe be prettier?
-    char ch;
+    // a number may end the text, that reads as '\0'
+    const auto next = [this]() {
+        const int c = get_char();
+        return c == EOF ? '\0' : static_cast<char>( c );
+    };
     number_sci_notation ret;
     int mod_e = 0;
     eat_whitespace();
-    stream->get( ch );
+    char ch = next();
     if( ( ret.negative = ch == '-' ) ) {
-        stream->get( ch );
+        ch = next();
     } else if( ch != '.' && ( ch < '0' || ch > '9' ) ) {
         // not a valid float
         std::stringstream err;
@@ -1285,7 +1510,7 @@ number_sci_notation JsonIn::get_any_number()
     }
     if( ch == '0' ) {
         // allow a single leading zero in front of a '.' or 'e'/'E'
-        stream->get( ch );
+        ch = next();
         if( ch >= '0' && ch <= '9' ) {
             error( "leading zeros not allowed", -1 );
         }
@@ -1293,36 +1518,41 @@ number_sci_notation JsonIn::get_any_number()
     while( ch >= '0' && ch <= '9' ) {
         ret.number *= 10;
         ret.number += ( ch - '0' );
-        stream->get( ch );
+        ch = next();
     }
     if( ch == '.' ) {
-        stream->get( ch );
+        ch = next();
         while( ch >= '0' && ch <= '9' ) {
             ret.number *= 10;
             ret.number += ( ch - '0' );
             mod_e -= 1;
-            stream->get( ch );
+            ch = next();
         }
     }
     if( ch == 'e' || ch == 'E' ) {
-        stream->get( ch );
+        ch = next();
         bool neg;
         if( ( neg = ch == '-' ) ) {
-            stream->get( ch );
+            ch = next();
         } else if( ch == '+' ) {
-            stream->get( ch );
+            ch = next();
         }
         while( ch >= '0' && ch <= '9' ) {
             ret.exp *= 10;
             ret.exp += ( ch - '0' );
-            stream->get( ch );
+            ch = next();
         }
         if( neg ) {
             ret.exp *= -1;
         }
     }
-    // unget the final non-number character (probably a separator)
-    stream->unget();
+    if( eof_bit ) {
+        // the number ends the text, so there's nothing to unget
+        fail_bit = false;
+    } else {
+        // unget the final non-number character (probably a separator)
+        unget_char();
+    }
     end_value();
     ret.exp += mod_e;
     return ret;
@@ -1330,13 +1560,13 @@ number_sci_notation JsonIn::get_any_number()
 
 bool JsonIn::get_bool()
 {
-    char ch;
+    char ch = '\0';
     char text[5];
     std::stringstream err;
     eat_whitespace();
-    stream->get( ch );
+    get_char( ch );
     if( ch == 't' ) {
-        stream->get( text, 4 );
+        get_text( text, 4 );
         if( strcmp( text, "rue" ) == 0 ) {
             end_value();
             return true;
@@ -1346,7 +1576,7 @@ bool JsonIn::get_bool()
             error( err.str(), -4 );
         }
     } else if( ch == 'f' ) {
-        stream->get( text, 5 );
+        get_text( text, 5 );
         if( strcmp( text, "alse" ) == 0 ) {
             end_value();
             return false;
@@ -1374,7 +1604,7 @@ void JsonIn::start_array()
 {
     eat_whitespace();
     if( peek() == '[' ) {
-        stream->get();
+        ignore_char();
         ate_separator = false;
         return;
     } else {
@@ -1394,7 +1624,7 @@ bool JsonIn::end_array()
             uneat_whitespace();
             error( "comma not allowed at end of array" );
         }
-        stream->get();
+        ignore_char();
         end_value();
         return true;
     } else {
@@ -1407,7 +1637,7 @@ void JsonIn::start_object()
 {
     eat_whitespace();
     if( peek() == '{' ) {
-        stream->get();
+        ignore_char();
         ate_separator = false; // not that we want to
         return;
     } else {
@@ -1427,7 +1657,7 @@ bool JsonIn::end_object()
             uneat_whitespace();
             error( "comma not allowed at end of object" );
         }
-        stream->get();
+        ignore_char();
         end_value();
         return true;
     } else {
@@ -1640,9 +1870,9 @@ bool JsonIn::read( JsonDeserializer &j, bool throw_on_error )
 std::string JsonIn::line_number( int offset_modifier )
 {
     const std::string &name = path ? *path : "<unknown source file>";
-    if( stream && stream->eof() ) {
+    if( eof_bit ) {
         return name + ":EOF";
-    } else if( !stream || stream->fail() ) {
+    } else if( fail_bit ) {
         return name + ":???";
     } // else stream is fine
     int pos = tell();
@@ -1651,15 +1881,15 @@ std::string JsonIn::line_number( int offset_modifier )
     char ch;
     seek( 0 );
     for( int i = 0; i < pos + offset_modifier; ++i ) {
-        stream->get( ch );
-        if( !stream->good() ) {
+        get_char( ch );
+        if( !good() ) {
             break;
         }
         if( ch == '\r' ) {
             offset = 1;
             ++line;
             if( peek() == '\n' ) {
-                stream->get();
+                ignore_char();
                 ++i;
             }
         } else if( ch == '\n' ) {
@@ -1680,17 +1910,18 @@ void JsonIn::error( const std::string &message, int offset )
     std::ostringstream err;
     err << "Json error: " << line_number( offset ) << ": " << message;
     // if we can't get more info from the stream don't try
-    if( !stream->good() ) {
+    if( !good() ) {
         throw JsonError( err.str() );
     }
     // also print surrounding few lines of context, if not too large
     err << "\n\n";
-    stream->seekg( offset, std::istream::cur );
+    move_by( offset );
     size_t pos = tell();
     rewind( 3, 240 );
     size_t startpos = tell();
-    std::string buffer( pos - startpos, '\0' );
-    stream->read( &buffer[0], pos - startpos );
+    const size_t count = std::min<size_t>( pos - startpos, text_end - cur );
+    std::string buffer( cur, count );
+    cur += count;
     auto it = buffer.begin();
     for( ; it < buffer.end() && ( *it == '\r' || *it == '\n' ); ++it ) {
         // skip starting newlines
@@ -1718,30 +1949,30 @@ void JsonIn::error( const std::string &message, int offset )
     err << "^\n";
     seek( pos );
     // if that wasn't the end of the line, continue underneath pointer
-    char ch = stream->get();
+    char ch = static_cast<char>( get_char() );
     if( ch == '\r' ) {
         if( peek() == '\n' ) {
-            stream->get();
+            ignore_char();
         }
     } else if( ch == '\n' ) {
         // pass
-    } else if( peek() != '\r' && peek() != '\n' && !stream->eof() ) {
+    } else if( peek() != '\r' && peek() != '\n' && !eof_bit ) {
         for( size_t i = 0; i < pos - startpos + 1; ++i ) {
             err << ' ';
         }
     }
     // print the next couple lines as well
     int line_count = 0;
-    for( int i = 0; line_count < 3 && stream->good() && i < 240; ++i ) {
-        stream->get( ch );
-        if( !stream->good() ) {
+    for( int i = 0; line_count < 3 && good() && i < 240; ++i ) {
+        get_char( ch );
+        if( !good() ) {
             break;
         }
         if( ch == '\r' ) {
             ch = '\n';
             ++line_count;
-            if( stream->peek() == '\n' ) {
-                stream->get( ch );
+            if( peek() == '\n' ) {
+                get_char( ch );
             }
         } else if( ch == '\n' ) {
             ++line_count;
@@ -1759,11 +1990,11 @@ void JsonIn::string_error( const std::string &message, const int offset )
 {
     if( test_string() ) {
         // skip quote mark
-        stream->ignore();
+        ignore_char();
         std::string s;
         std::string err;
         for( int i = 0; i < offset; ++i ) {
-            if( !get_escaped_or_unicode( *stream, s, err ) ) {
+            if( !get_escaped_or_unicode( s, err ) ) {
                 break;
             }
         }
@@ -1790,15 +2021,15 @@ void JsonIn::rewind( int max_lines, int max_chars )
         return;
     }
     int lines_found = 0;
-    stream->seekg( -1, std::istream::cur );
+    move_by( -1 );
     for( int i = 0; i < max_chars; ++i ) {
         size_t tellpos = tell();
         if( peek() == '\n' ) {
             ++lines_found;
             if( tellpos > 0 ) {
-                stream->seekg( -1, std::istream::cur );
+                move_by( -1 );
                 if( peek() != '\r' ) {
-                    stream->seekg( 1, std::istream::cur );
+                    move_by( 1 );
                 } else {
                     --tellpos;
                 }
@@ -1809,33 +2040,29 @@ void JsonIn::rewind( int max_lines, int max_chars )
         if( lines_found == max_lines ) {
             // don't include the last \n or \r
             if( peek() == '\n' ) {
-                stream->seekg( 1, std::istream::cur );
+                move_by( 1 );
             } else if( peek() == '\r' ) {
-                stream->seekg( 1, std::istream::cur );
+                move_by( 1 );
                 if( peek() == '\n' ) {
-                    stream->seekg( 1, std::istream::cur );
+                    move_by( 1 );
                 }
             }
             break;
         } else if( tellpos == 0 ) {
             break;
         }
-        stream->seekg( -1, std::istream::cur );
+        move_by( -1 );
     }
 }
 
 std::string JsonIn::substr( size_t pos, size_t len )
 {
-    std::string ret;
-    if( len == std::string::npos ) {
-        stream->seekg( 0, std::istream::end );
-        size_t end = tell();
-        len = end - pos;
-    }
-    ret.resize( len );
-    stream->seekg( pos );
-    stream->read( &ret[0], len );
-    return ret;
+    const size_t size = text_end - text_begin;
+    pos = std::min( pos, size );
+    len = std::min( len, size - pos );
+    eof_bit = false;
+    cur = text_begin + pos + len;
+    return std::string( text_begin + pos, len );
 }
 
 JsonOut::JsonOut( std::ostream &s, bool pretty, int depth ) :
@@ -2079,10 +2306,12 @@ JsonIn &JsonValue::seek() const
 
 JsonValue JsonObject::get_member( const std::string &name ) const
 {
-    const auto iter = positions.find( name );
-    if( !jsin || iter == positions.end() ) {
+    const member_position *member = find_member( name );
+    if( !jsin || member == nullptr ) {
         throw_error( "missing required field \"" + name + "\" in object: " + str() );
     }
-    mark_visited( name );
-    return JsonValue( *jsin, iter->second );
+#ifndef CATA_IN_TOOL
+    member->visited = true;
+#endif
+    return JsonValue( *jsin, member->position );
 }
@@ -96,8 +96,9 @@ struct json_source_location {
 /* JsonIn
  * ======
  *
- * The JsonIn class provides a wrapper around a std::istream,
- * with methods for reading JSON data directly from the stream.
+ * The JsonIn class reads JSON data from text held in memory.
+ * It can be given the text directly, or a std::istream which it reads
+ * completely before parsing.
  *
  * JsonObject and JsonArray provide higher-level wrappers,
  * and are a little easier to use in most cases,
@@ -119,7 +120,7 @@ struct json_source_location {
  *
  * If the JSON structure is not as expected,
  * verbose error messages are provided, indicating the problem,
- * and the exact line number and byte offset within the istream.
+ * and the exact line number and byte offset within the text.
  *
  *
  * Single-Pass Loading
@@ -176,24 +177,49 @@ struct json_source_location {
 class JsonIn
 {
     private:
-        std::istream *stream;
+        // The text being parsed, either owned_text or text owned by the caller
+        const char *text_begin = nullptr;
+        const char *text_end = nullptr;
+        const char *cur = nullptr;
+        std::string owned_text;
+        // Stream the text was read from, left at the position parsing stopped at
+        std::istream *source = nullptr;
+        // Same meaning as the state bits of a std::istream reading the text
+        bool eof_bit = false;
+        bool fail_bit = false;
+
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
 
+        void read_source( std::istream &s );
+
+        // Reading single characters, they end up in the same state as std::istream would
+        bool sentry();
+        int get_char();
+        bool get_char( char &ch );
+        void get_text( char *dest, size_t size );
+        void unget_char();
+        void ignore_char();
+        void move_by( int offset );
+        bool get_escaped_or_unicode( std::string &s, std::string &err );
+
         void skip_separator();
         void skip_pair_separator();
         void end_value();
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
-        JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
-        JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
-            seek( loc.offset );
-        }
+        JsonIn( std::istream &s );
+        JsonIn( std::istream &s, const std::string &path );
+        JsonIn( std::istream &s, const json_source_location &loc );
+        /** Parses @p text, which has to outlive the JsonIn and everything read from it. */
+        JsonIn( const std::string &text, const std::string &path );
+        JsonIn( const std::string &text, const json_source_location &loc );
+        // A temporary would be gone before parsing
+        JsonIn( const std::string &&text, const std::string &path ) = delete;
+        JsonIn( const std::string &&text, const json_source_location &loc ) = delete;
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
+        ~JsonIn();
 
         shared_ptr_fast<std::string> get_path() const {
             return path;
@@ -831,15 +857,24 @@ class JsonOut
 class JsonObject
 {
     private:
-        std::map<std::string, int> positions;
+        struct member_position {
+            std::string name;
+            int position;
+            // Whether the member has been looked at, see report_unvisited
+            mutable bool visited;
+        };
+        // Sorted by name, so that members are found with a binary search
+        std::vector<member_position> members;
         int start;
         int end_;
         bool final_separator = false;
 #ifndef CATA_IN_TOOL
-        mutable std::set<std::string> visited_members;
         mutable bool report_unvisited_members = true;
         mutable bool reported_unvisited_members = false;
 #endif
+        // First member not ordered before name, members.end() if there is none
+        std::vector<member_position>::const_iterator lower_bound( const std::string &name ) const;
+        const member_position *find_member( const std::string &name ) const;
         void mark_visited( const std::string &name ) const;
         void report_unvisited() const;
 
@@ -1271,7 +1306,7 @@ class JsonObject::const_iterator
 {
     private:
         const JsonObject &object_;
-        decltype( JsonObject::positions )::const_iterator iter_;
+        decltype( JsonObject::members )::const_iterator iter_;
 
     public:
         const_iterator( const JsonObject &object, const decltype( iter_ ) &iter ) : object_( object ),
@@ -1282,8 +1317,10 @@ class JsonObject::const_iterator
             return *this;
         }
         JsonMember operator*() const {
-            object_.mark_visited( iter_->first );
-            return JsonMember( iter_->first, JsonValue( *object_.jsin, iter_->second ) );
+#ifndef CATA_IN_TOOL
+            iter_->visited = true;
+#endif
+            return JsonMember( iter_->name, JsonValue( *object_.jsin, iter_->position ) );
         }
 
         friend bool operator==( const const_iterator &lhs, const const_iterator &rhs ) {
@@ -1296,12 +1333,12 @@ class JsonObject::const_iterator
 
 inline JsonObject::const_iterator JsonObject::begin() const
 {
-    return const_iterator( *this, positions.begin() );
+    return const_iterator( *this, members.begin() );
 }
 
 inline JsonObject::const_iterator JsonObject::end() const
 {
-    return const_iterator( *this, positions.end() );
+    return const_iterator( *this, members.end() );
 }
 
 template <typename T>
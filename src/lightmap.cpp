@@ -1,14 +1,19 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
+#include <bitset>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "avatar.h"
+#include "cache_kernels.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -39,6 +44,7 @@
 #include "vpart_position.h"
 #include "vpart_range.h"
 #include "weather.h"
+#include "worker_pool.h"
 
 static const efftype_id effect_haslight( "haslight" );
 static const efftype_id effect_onfire( "onfire" );
@@ -51,6 +57,50 @@ static constexpr point lightmap_boundary_max( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y
 
 const rectangle lightmap_boundaries( lightmap_boundary_min, lightmap_boundary_max );
 
+// Light of the source currently cast on this thread by map::cast_light_contribution,
+// zeroed after each use
+static thread_local four_quadrants light_scratch[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y];
+
+// Directions a point light is cast into, see map::apply_light_source
+static constexpr int light_north = 1;
+static constexpr int light_south = 2;
+static constexpr int light_east = 4;
+static constexpr int light_west = 8;
+
+static bool light_source_less( const light_contribution &l, const light_contribution &r )
+{
+    return std::tie( l.type, l.pos.x, l.pos.y, l.angle, l.spread, l.luminance ) <
+           std::tie( r.type, r.pos.x, r.pos.y, r.angle, r.spread, r.luminance );
+}
+
+static bool reaches_dirty_submap( const light_contribution &contribution,
+                                  const std::bitset<MAPSIZE *MAPSIZE> &dirty )
+{
+    if( contribution.light.empty() ) {
+        return false;
+    }
+    for( int smx = contribution.min.x / SEEX; smx <= ( contribution.max.x - 1 ) / SEEX; ++smx ) {
+        for( int smy = contribution.min.y / SEEY; smy <= ( contribution.max.y - 1 ) / SEEY; ++smy ) {
+            if( dirty[smx * MAPSIZE + smy] ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Distance from the source beyond which its light can't reach
+static int light_reach( const light_contribution &source )
+{
+    if( source.type == light_contribution::source_type::arc ) {
+        // Rays end at LIGHT_RANGE, plus rounding
+        return std::max( 1, LIGHT_RANGE( source.luminance ) + 2 );
+    }
+    // Shadowcasting stops after the first row where luminance / distance is below LIGHT_AMBIENT_LOW,
+    // and never goes beyond 60 squares
+    return std::min( 60, static_cast<int>( std::ceil( source.luminance / LIGHT_AMBIENT_LOW ) ) + 1 );
+}
+
 std::string four_quadrants::to_string() const
 {
     return string_format( "(%.2f,%.2f,%.2f,%.2f)",
@@ -91,8 +141,8 @@ bool map::build_transparency_cache( const int zlev )
 
     if( rebuild_all ) {
         // Default to just barely not transparent.
-        std::uninitialized_fill_n( &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
-                                   static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+        cache_kernels::fill( &transparency_cache[0][0], LIGHT_TRANSPARENCY_OPEN_AIR,
+                             MAPSIZE_X * MAPSIZE_Y );
     }
 
     const float sight_penalty = weather::sight_penalty( g->weather.weather );
@@ -156,6 +206,7 @@ bool map::build_transparency_cache( const int zlev )
             }
         }
     }
+    map_cache.lightmap_dirty |= map_cache.transparency_cache_dirty;
     map_cache.transparency_cache_dirty.reset();
     return true;
 }
@@ -204,6 +255,8 @@ void map::apply_character_light( Character &p )
         apply_light_source( p.pos(), held_luminance );
     }
 
+    // The check below needs the light applied so far
+    cast_pending_light( get_cache( p.posz() ) );
     if( held_luminance >= 4 && held_luminance > ambient_light_at( p.pos() ) - 0.5f ) {
         p.add_effect( effect_haslight, 1_turns );
     }
@@ -385,6 +438,17 @@ void map::generate_lightmap( const int zlev )
     auto &light_source_buffer = map_cache.light_source_buffer;
     std::memset( light_source_buffer, 0, sizeof( light_source_buffer ) );
 
+    // Light from the last call can be reused unless it reaches a submap with changed transparency
+    auto &reusable = map_cache.reusable_light_contributions;
+    reusable.clear();
+    reusable.swap( map_cache.light_contributions );
+    reusable.erase( std::remove_if( reusable.begin(), reusable.end(),
+    [&map_cache]( const light_contribution & contribution ) {
+        return reaches_dirty_submap( contribution, map_cache.lightmap_dirty );
+    } ), reusable.end() );
+    std::sort( reusable.begin(), reusable.end(), light_source_less );
+    map_cache.lightmap_dirty.reset();
+
     constexpr std::array<int, 4> dir_x = { {  0, -1, 1, 0 } };    //    [0]
     constexpr std::array<int, 4> dir_y = { { -1,  0, 0, 1 } };    // [1][X][2]
     constexpr std::array<int, 4> dir_d = { { 90, 0, 180, 270 } }; //    [3]
@@ -568,9 +632,113 @@ void map::generate_lightmap( const int zlev )
             apply_light_source( p, light_source_buffer[p.x][p.y] );
         }
     }
+    cast_pending_light( map_cache );
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
+    reusable.clear();
+}
+
+void map::apply_light_contribution( light_contribution &&source )
+{
+    auto &cache = get_cache( source.pos.z );
+    auto &reusable = cache.reusable_light_contributions;
+    const auto found = std::lower_bound( reusable.begin(), reusable.end(), source,
+                                         light_source_less );
+    if( found != reusable.end() && !light_source_less( source, *found ) ) {
+        if( found->light.empty() && found->min != found->max ) {
+            // Already taken by an identical source, which added the same light
+            return;
+        }
+        source = std::move( *found );
+        found->light.clear();
+    } else if( parallel_shadowcasting && get_worker_pool().threads() > 1 ) {
+        // Cast later, together with the other new sources, see cast_pending_light
+        cache.pending_light_contributions.push_back( std::move( source ) );
+        return;
+    } else {
+        cast_light_contribution( source );
+    }
+    add_light_contribution( cache, std::move( source ) );
+}
+
+void map::cast_pending_light( level_cache &cache )
+{
+    auto &pending = cache.pending_light_contributions;
+    get_worker_pool().run( pending.size(), [this, &pending]( const size_t i ) {
+        cast_light_contribution( pending[i] );
+    } );
+    for( light_contribution &source : pending ) {
+        add_light_contribution( cache, std::move( source ) );
+    }
+    pending.clear();
+}
+
+void map::cast_light_contribution( light_contribution &source )
+{
+    switch( source.type ) {
+        case light_contribution::source_type::point:
+            cast_light_source( source.pos, source.luminance, source.spread );
+            break;
+        case light_contribution::source_type::directional:
+            cast_directional_light( source.pos, source.angle, source.luminance );
+            break;
+        case light_contribution::source_type::arc:
+            cast_light_arc( source.pos, source.angle, source.luminance, source.spread );
+            break;
+    }
+
+    const int reach = light_reach( source );
+    const point from( std::max( source.pos.x - reach, 0 ), std::max( source.pos.y - reach, 0 ) );
+    const point to( std::min( source.pos.x + reach + 1, LIGHTMAP_CACHE_X ),
+                    std::min( source.pos.y + reach + 1, LIGHTMAP_CACHE_Y ) );
+    source.min = to;
+    source.max = from;
+    for( int x = from.x; x < to.x; ++x ) {
+        for( int y = from.y; y < to.y; ++y ) {
+            if( light_scratch[x][y].max() > 0.0f ) {
+                source.min = point( std::min( source.min.x, x ), std::min( source.min.y, y ) );
+                source.max = point( std::max( source.max.x, x + 1 ), std::max( source.max.y, y + 1 ) );
+            }
+        }
+    }
+    if( source.min.x < source.max.x ) {
+        source.light.reserve( ( source.max.x - source.min.x ) * ( source.max.y - source.min.y ) );
+        for( int x = source.min.x; x < source.max.x; ++x ) {
+            source.light.insert( source.light.end(), &light_scratch[x][source.min.y],
+                                 &light_scratch[x][source.max.y] );
+        }
+    } else {
+        source.min = source.pos.xy();
+        source.max = source.pos.xy();
+    }
+    for( int x = from.x; x < to.x; ++x ) {
+        std::fill( &light_scratch[x][from.y], &light_scratch[x][to.y], four_quadrants( 0.0f ) );
+    }
+
+    if( inbounds( source.pos ) ) {
+        if( source.type == light_contribution::source_type::point ) {
+            source.source_light = source.luminance;
+        } else if( source.type == light_contribution::source_type::arc ) {
+            source.source_light = LIGHT_SOURCE_LOCAL;
+        }
+    }
+}
+
+void map::add_light_contribution( level_cache &cache, light_contribution &&source )
+{
+    auto &lm = cache.lm;
+    auto light = source.light.cbegin();
+    for( int x = source.min.x; x < source.max.x; ++x ) {
+        for( int y = source.min.y; y < source.max.y; ++y ) {
+            lm[x][y] = elementwise_max( lm[x][y], *light++ );
+        }
+    }
+    if( source.source_light > 0.0f ) {
+        float &sm = cache.sm[source.pos.x][source.pos.y];
+        sm = std::max( sm, source.source_light );
+    }
+    cache.light_contributions.push_back( std::move( source ) );
 }
 
 void map::add_light_source( const tripoint &p, float luminance )
@@ -698,8 +866,13 @@ lit_level map::apparent_light_at( const tripoint &p, const visibility_variables
         return LL_BRIGHT;
     }
     const auto &map_cache = get_cache_ref( p.z );
-    const apparent_light_info a = apparent_light_helper( map_cache, p );
+    return apparent_light_level( map_cache, p, dist, apparent_light_helper( map_cache, p ), cache );
+}
 
+lit_level map::apparent_light_level( const level_cache &map_cache, const tripoint &p,
+                                     const int dist, const apparent_light_info &a,
+                                     const visibility_variables &cache )
+{
     // Unimpaired range is an override to strictly limit vision range based on various conditions,
     // but the player can still see light sources.
     if( dist > g->u.unimpaired_range() ) {
@@ -1204,6 +1377,93 @@ castLightAll<float, float, shrapnel_calc, shrapnel_check,
     const float( &input_array )[MAPSIZE_X][MAPSIZE_Y],
     const point &offset, int offsetDistance, float numerator );
 
+// Casts one octant, in the order castLightAll uses
+template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         void( *update_output )( Out &, const T &, quadrant ),
+         T( *accumulate )( const T &, const T &, const int & )>
+static void castLightOctant( const int octant, Out( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                             const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                             const point &offset, int offsetDistance, T numerator )
+{
+    switch( octant ) {
+        case 0:
+            castLight<0, 1, 1, 0, T, Out, calc, check, update_output, accumulate>(
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 1:
+            castLight<1, 0, 0, 1, T, Out, calc, check, update_output, accumulate>(
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 2:
+            castLight < 0, -1, 1, 0, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 3:
+            castLight < -1, 0, 0, 1, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 4:
+            castLight < 0, 1, -1, 0, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 5:
+            castLight < 1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 6:
+            castLight < 0, -1, -1, 0, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+        case 7:
+            castLight < -1, 0, 0, -1, T, Out, calc, check, update_output, accumulate > (
+                output_cache, input_array, offset, offsetDistance, numerator );
+            break;
+    }
+}
+
+// castLightAll into a cache that keeps the highest value cast into each tile. With parallel
+// shadowcasting the octants are split over the worker pool, each task casting into its own
+// buffer, and the buffers are merged afterwards.
+template<typename T, T( *calc )( const T &, const T &, const int & ),
+         bool( *check )( const T &, const T & ),
+         T( *accumulate )( const T &, const T &, const int & )>
+static void castLightAllMax( float ( &output_cache )[MAPSIZE_X][MAPSIZE_Y],
+                             const T( &input_array )[MAPSIZE_X][MAPSIZE_Y],
+                             const point &offset, int offsetDistance, T numerator = 1.0 )
+{
+    // The option is checked first, so the pool isn't started unless it's used
+    if( !parallel_shadowcasting || get_worker_pool().threads() == 1 ) {
+        castLightAll<T, float, calc, check, update_light, accumulate>(
+            output_cache, input_array, offset, offsetDistance, numerator );
+        return;
+    }
+    worker_pool &pool = get_worker_pool();
+
+    struct grid {
+        float cells[MAPSIZE_X][MAPSIZE_Y];
+    };
+    constexpr size_t octants = 8;
+    constexpr size_t map_dimensions = MAPSIZE_X * MAPSIZE_Y;
+    static std::vector<std::unique_ptr<grid>> buffers;
+    const size_t tasks = std::min<size_t>( octants, pool.threads() );
+    while( buffers.size() < tasks ) {
+        buffers.emplace_back( std::make_unique<grid>() );
+    }
+    pool.run( tasks, [&]( const size_t task ) {
+        float ( &buffer )[MAPSIZE_X][MAPSIZE_Y] = buffers[task]->cells;
+        cache_kernels::fill( &buffer[0][0], 0.0f, map_dimensions );
+        for( size_t octant = task; octant < octants; octant += tasks ) {
+            castLightOctant<T, float, calc, check, update_light, accumulate>(
+                octant, buffer, input_array, offset, offsetDistance, numerator );
+        }
+    } );
+    for( size_t task = 0; task < tasks; ++task ) {
+        cache_kernels::elementwise_max( &output_cache[0][0], &buffers[task]->cells[0][0],
+                                        &output_cache[0][0], map_dimensions );
+    }
+}
+
 /**
  * Calculates the Field Of View for the provided map from the given x, y
  * coordinates. Returns a lightmap for a result where the values represent a
@@ -1225,21 +1485,20 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
 
     constexpr float light_transparency_solid = LIGHT_TRANSPARENCY_SOLID;
     constexpr int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
-    std::uninitialized_fill_n(
-        &camera_cache[0][0], map_dimensions, light_transparency_solid );
+    cache_kernels::fill( &camera_cache[0][0], light_transparency_solid, map_dimensions );
 
     if( !fov_3d ) {
         for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
             auto &cur_cache = get_cache( z );
             if( z == target_z || cur_cache.seen_cache_dirty ) {
-                std::uninitialized_fill_n(
-                    &cur_cache.seen_cache[0][0], map_dimensions, light_transparency_solid );
+                cache_kernels::fill( &cur_cache.seen_cache[0][0], light_transparency_solid,
+                                     map_dimensions );
                 cur_cache.seen_cache_dirty = false;
             }
 
             if( z == target_z ) {
                 seen_cache[origin.x][origin.y] = VISIBILITY_FULL;
-                castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+                castLightAllMax<float, sight_calc, sight_check, accumulate_transparency>(
                     seen_cache, transparency_cache, origin.xy(), 0 );
             }
         }
@@ -1253,8 +1512,8 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
             transparency_caches[z + OVERMAP_DEPTH] = &cur_cache.vision_transparency_cache;
             seen_caches[z + OVERMAP_DEPTH] = &cur_cache.seen_cache;
             floor_caches[z + OVERMAP_DEPTH] = &cur_cache.floor_cache;
-            std::uninitialized_fill_n(
-                &cur_cache.seen_cache[0][0], map_dimensions, light_transparency_solid );
+            cache_kernels::fill( &cur_cache.seen_cache[0][0], light_transparency_solid,
+                                 map_dimensions );
             cur_cache.seen_cache_dirty = false;
         }
         if( origin.z == target_z ) {
@@ -1316,7 +1575,7 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
         //
         // The naive solution of making the mirrors act like a second player
         // at an offset appears to give reasonable results though.
-        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+        castLightAllMax<float, sight_calc, sight_check, accumulate_transparency>(
             camera_cache, transparency_cache, mirror_pos.xy(), offsetDistance );
     }
 }
@@ -1353,11 +1612,53 @@ static bool light_check( const float &transparency, const float &intensity )
 
 void map::apply_light_source( const tripoint &p, float luminance )
 {
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+    light_contribution source;
+    source.type = light_contribution::source_type::point;
+    source.pos = p;
+    source.luminance = luminance;
+    if( luminance > LL_LOW ) {
+        const float cast_luminance = luminance <= LL_BRIGHT_ONLY ? 1.49f : luminance;
+        const auto &light_source_buffer = get_cache_ref( p.z ).light_source_buffer;
+        const int x = p.x;
+        const int y = p.y;
+
+        /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+             neighboring fires to the north and west that were applied via light_source_buffer
+           If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+           If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+             add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+              ey
+            nnnNnnn
+            w     e
+            w  5 +e
+         sx W 5*1+E ex
+            w ++++e
+            w+++++e
+            sssSsss
+               sy
+        */
+        const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
+        if( y != 0 && light_source_buffer[x][y - 1] < cast_luminance ) {
+            source.spread |= light_north;
+        }
+        if( y != peer_inbounds && light_source_buffer[x][y + 1] < cast_luminance ) {
+            source.spread |= light_south;
+        }
+        if( x != peer_inbounds && light_source_buffer[x + 1][y] < cast_luminance ) {
+            source.spread |= light_east;
+        }
+        if( x != 0 && light_source_buffer[x - 1][y] < cast_luminance ) {
+            source.spread |= light_west;
+        }
+    }
+    apply_light_contribution( std::move( source ) );
+}
+
+void map::cast_light_source( const tripoint &p, float luminance, const int directions )
+{
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = light_scratch;
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = get_cache( p.z ).transparency_cache;
 
     const int x = p.x;
     const int y = p.y;
@@ -1365,7 +1666,6 @@ void map::apply_light_source( const tripoint &p, float luminance )
     if( inbounds( p ) ) {
         const float min_light = std::max( static_cast<float>( LL_LOW ), luminance );
         lm[x][y] = elementwise_max( lm[x][y], min_light );
-        sm[x][y] = std::max( sm[x][y], luminance );
     }
     if( luminance <= LL_LOW ) {
         return;
@@ -1373,27 +1673,10 @@ void map::apply_light_source( const tripoint &p, float luminance )
         luminance = 1.49f;
     }
 
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
-
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
-    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( y != 0 && light_source_buffer[x][y - 1] < luminance );
-    bool south = ( y != peer_inbounds && light_source_buffer[x][y + 1] < luminance );
-    bool east = ( x != peer_inbounds && light_source_buffer[x + 1][y] < luminance );
-    bool west = ( x != 0 && light_source_buffer[x - 1][y] < luminance );
+    const bool north = ( directions & light_north ) != 0;
+    const bool south = ( directions & light_south ) != 0;
+    const bool east = ( directions & light_east ) != 0;
+    const bool west = ( directions & light_west ) != 0;
 
     if( north ) {
         castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
@@ -1433,13 +1716,22 @@ void map::apply_light_source( const tripoint &p, float luminance )
 }
 
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
+{
+    light_contribution source;
+    source.type = light_contribution::source_type::directional;
+    source.pos = p;
+    source.luminance = luminance;
+    source.angle = direction;
+    apply_light_contribution( std::move( source ) );
+}
+
+void map::cast_directional_light( const tripoint &p, int direction, float luminance )
 {
     const int x = p.x;
     const int y = p.y;
 
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = light_scratch;
+    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = get_cache( p.z ).transparency_cache;
 
     if( direction == 90 ) {
         castLight < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
@@ -1478,9 +1770,20 @@ void map::apply_light_arc( const tripoint &p, int angle, float luminance, int wi
         return;
     }
 
+    light_contribution source;
+    source.type = light_contribution::source_type::arc;
+    source.pos = p;
+    source.luminance = luminance;
+    source.angle = angle;
+    source.spread = wideangle;
+    apply_light_contribution( std::move( source ) );
+}
+
+void map::cast_light_arc( const tripoint &p, int angle, float luminance, int wideangle )
+{
     bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
 
-    apply_light_source( p, LIGHT_SOURCE_LOCAL );
+    cast_light_source( p, LIGHT_SOURCE_LOCAL, 0 );
 
     // Normalize (should work with negative values too)
     const double wangle = wideangle / 2.0;
@@ -1546,7 +1849,7 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
         return;
     }
 
-    auto &lm = get_cache( s.z ).lm;
+    auto &lm = light_scratch;
     auto &transparency_cache = get_cache( s.z ).transparency_cache;
 
     float distance = 1.0;
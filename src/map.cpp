@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include <ostream>
 #include <queue>
 #include <type_traits>
@@ -18,6 +19,7 @@
 #include "avatar.h"
 #include "basecamp.h"
 #include "bodypart.h"
+#include "cache_kernels.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -85,6 +87,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui_manager.h"
 #include "value_ptr.h"
 #include "veh_type.h"
@@ -111,6 +114,8 @@ static const std::string flag_USES_GRID_POWER( "USES_GRID_POWER" );
 static cata::colony<item> nulitems;          // Returned when &i_at() is asked for an OOB value
 static field              nulfield;          // Returned when &field_at() is asked for an OOB value
 static level_cache        nullcache;         // Dummy cache for z-levels outside bounds
+// Monsters may look through map::sees from several threads while they plan
+static std::mutex skew_vision_cache_mutex;
 
 map &get_map()
 {
@@ -157,6 +162,8 @@ map::map( int mapsize, bool zlev )
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    cached_routes = std::make_unique<route_cache>();
+    route_portal_graph = std::make_unique<submap_portals>( my_MAPSIZE );
 
     dbg( DL::Info ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -232,6 +239,25 @@ void map::reset_vehicle_cache( const int zlev )
     }
 }
 
+namespace
+{
+// Tiles vehicle parts left or entered, routes and portals elsewhere stay valid
+struct vehicle_parts_box {
+    tripoint min = tripoint( INT_MAX, INT_MAX, INT_MAX );
+    tripoint max = tripoint( INT_MIN, INT_MIN, INT_MIN );
+
+    void add( const tripoint &p ) {
+        min = tripoint( std::min( min.x, p.x ), std::min( min.y, p.y ), std::min( min.z, p.z ) );
+        max = tripoint( std::max( max.x, p.x ), std::max( max.y, p.y ), std::max( max.z, p.z ) );
+    }
+    void set_pathfinding_cache_dirty( map &m ) const {
+        if( min.x <= max.x ) {
+            m.set_pathfinding_cache_dirty( min, max );
+        }
+    }
+};
+} // namespace
+
 void map::add_vehicle_to_cache( vehicle *veh )
 {
     if( veh == nullptr ) {
@@ -244,6 +270,7 @@ void map::add_vehicle_to_cache( vehicle *veh )
     // Get parts
     std::vector<vehicle_part> &parts = veh->parts;
     int partid = 0;
+    vehicle_parts_box entered;
     for( std::vector<vehicle_part>::iterator it = parts.begin(),
          end = parts.end(); it != end; ++it, ++partid ) {
         if( it->removed ) {
@@ -254,10 +281,13 @@ void map::add_vehicle_to_cache( vehicle *veh )
                                     std::make_pair( veh, partid ) ) );
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = true;
+            entered.add( p );
         }
     }
 
     last_full_vehicle_list_dirty = true;
+    // Routes may lead through where the parts are now
+    entered.set_pathfinding_cache_dirty( *this );
 }
 
 void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
@@ -271,11 +301,13 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
     auto &ch = get_cache( old_zlevel );
     auto it = ch.veh_cached_parts.begin();
     const auto end = ch.veh_cached_parts.end();
+    vehicle_parts_box left;
     while( it != end ) {
         if( it->second.first == veh ) {
             const tripoint p = it->first;
             if( inbounds( p ) ) {
                 ch.veh_exists_at[p.x][p.y] = false;
+                left.add( p );
             }
             ch.veh_cached_parts.erase( it++ );
             // If something was resting on vehicle, drop it
@@ -284,6 +316,8 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
             ++it;
         }
     }
+    // Routes may have been blocked by where the parts were
+    left.set_pathfinding_cache_dirty( *this );
 
     add_vehicle_to_cache( veh );
 }
@@ -291,14 +325,17 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 void map::clear_vehicle_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
+    vehicle_parts_box moved;
     while( !ch.veh_cached_parts.empty() ) {
         const auto part = ch.veh_cached_parts.begin();
         const auto &p = part->first;
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = false;
+            moved.add( p );
         }
         ch.veh_cached_parts.erase( part );
     }
+    moved.set_pathfinding_cache_dirty( *this );
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -377,11 +414,12 @@ void map::on_vehicle_moved( const int smz )
     set_transparency_cache_dirty( smz );
     set_floor_cache_dirty( smz );
     set_floor_cache_dirty( smz + 1 );
-    set_pathfinding_cache_dirty( smz );
+    // Updating the vehicle cache already dirtied the pathfinding around the old and new parts
 }
 
 void map::vehmove()
 {
+    CATA_PROFILE_ZONE( "map::vehmove" );
     // give vehicles movement points
     VehicleList vehicle_list;
     int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
@@ -1331,6 +1369,9 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
     if( new_t.has_flag( "EMITTER" ) ) {
         field_furn_locs.push_back( p );
     }
+    if( old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
+    }
     if( old_t.transparent != new_t.transparent ) {
         set_transparency_cache_dirty( p );
         set_seen_cache_dirty( p );
@@ -1354,7 +1395,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1599,6 +1640,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         traplocs[new_t.trap.to_i()].push_back( p );
     }
 
+    if( old_t.has_flag( TFLAG_NO_SCENT ) != new_t.has_flag( TFLAG_NO_SCENT ) ||
+        old_t.has_flag( TFLAG_REDUCE_SCENT ) != new_t.has_flag( TFLAG_REDUCE_SCENT ) ) {
+        set_scent_cache_dirty( p );
+    }
     if( old_t.transparent != new_t.transparent ) {
         set_transparency_cache_dirty( p );
         set_seen_cache_dirty( p );
@@ -1619,7 +1664,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -2241,6 +2286,35 @@ bool map::has_flag_ter_or_furn( const std::string &flag, const tripoint &p ) con
         return false;
     }
 
+    point l;
+    submap *const current_submap = get_submap_at( p, l );
+    const int index = map_data_common_t::flag_index( flag );
+
+    return current_submap->get_ter( l ).obj().has_flag_index( index ) ||
+           current_submap->get_furn( l ).obj().has_flag_index( index );
+}
+
+bool map::has_flag( const ter_furn_flag &flag, const tripoint &p ) const
+{
+    return has_flag_ter_or_furn( flag, p ); // Does bound checking
+}
+
+bool map::has_flag_ter( const ter_furn_flag &flag, const tripoint &p ) const
+{
+    return ter( p ).obj().has_flag( flag );
+}
+
+bool map::has_flag_furn( const ter_furn_flag &flag, const tripoint &p ) const
+{
+    return furn( p ).obj().has_flag( flag );
+}
+
+bool map::has_flag_ter_or_furn( const ter_furn_flag &flag, const tripoint &p ) const
+{
+    if( !inbounds( p ) ) {
+        return false;
+    }
+
     point l;
     submap *const current_submap = get_submap_at( p, l );
 
@@ -2603,31 +2677,29 @@ void map::decay_fields_and_scent( const time_duration &amount )
                 continue;
             }
 
-            for( int sx = 0; sx < SEEX; ++sx ) {
+            for( const point &l : cur_submap->field_tiles ) {
                 if( to_proc < 1 ) {
                     // This submap had some fields, but all got proc'd already
                     break;
                 }
 
-                for( int sy = 0; sy < SEEY; ++sy ) {
-                    const int x = sx + smx * SEEX;
-                    const int y = sy + smy * SEEY;
+                const int x = l.x + smx * SEEX;
+                const int y = l.y + smy * SEEY;
 
-                    field &fields = cur_submap->get_field( { sx, sy} );
-                    if( !outside_cache[x][y] ) {
-                        to_proc -= fields.field_count();
-                        continue;
-                    }
+                field &fields = cur_submap->get_field( l );
+                if( !outside_cache[x][y] ) {
+                    to_proc -= fields.field_count();
+                    continue;
+                }
 
-                    for( auto &fp : fields ) {
-                        to_proc--;
-                        field_entry &cur = fp.second;
-                        const field_type_id type = cur.get_field_type();
-                        const int decay_amount_factor =  type.obj().decay_amount_factor;
-                        if( decay_amount_factor != 0 ) {
-                            const time_duration decay_amount = amount / decay_amount_factor;
-                            cur.set_field_age( cur.get_field_age() + decay_amount );
-                        }
+                for( auto &fp : fields ) {
+                    to_proc--;
+                    field_entry &cur = fp.second;
+                    const field_type_id type = cur.get_field_type();
+                    const int decay_amount_factor =  type.obj().decay_amount_factor;
+                    if( decay_amount_factor != 0 ) {
+                        const time_duration decay_amount = amount / decay_amount_factor;
+                        cur.set_field_age( cur.get_field_age() + decay_amount );
                     }
                 }
             }
@@ -4520,6 +4592,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    CATA_PROFILE_ZONE( "map::process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -4536,7 +4609,8 @@ void map::process_items()
         }
     }
     // Making a copy, in case the original variable gets modified during `process_items_in_submap`
-    const std::set<tripoint> submaps_with_active_items_copy = submaps_with_active_items;
+    const std::vector<tripoint> submaps_with_active_items_copy( submaps_with_active_items.begin(),
+            submaps_with_active_items.end() );
     for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
         const tripoint local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
@@ -5143,6 +5217,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5224,6 +5299,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        set_pathfinding_cache_dirty( p );
     }
 }
 /*
@@ -5360,8 +5436,11 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     invalidate_max_populated_zlev( p.z );
 
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
+        current_submap->mark_field_tile( l );
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
+            // The first field on a submap starts out up to date
+            current_submap->fields_updated = calendar::turn;
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
@@ -5382,7 +5461,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5414,7 +5493,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -5536,15 +5615,42 @@ void map::update_visibility_cache( const int zlev )
     int sm_squares_seen[MAPSIZE][MAPSIZE];
     std::memset( sm_squares_seen, 0, sizeof( sm_squares_seen ) );
 
-    auto &visibility_cache = get_cache( zlev ).visibility_cache;
-
+    level_cache &map_cache = get_cache( zlev );
+    auto &visibility_cache = map_cache.visibility_cache;
+
+    // The light seen on tiles that aren't opaque is just visibility times brightest light,
+    // so that is done in bulk. Opaque tiles depend on their neighbours, see apparent_light_helper.
+    constexpr size_t map_dimensions = MAPSIZE_X * MAPSIZE_Y;
+    std::vector<float> visibility( map_dimensions );
+    std::vector<float> apparent_light( map_dimensions );
+    cache_kernels::elementwise_max( &map_cache.seen_cache[0][0], &map_cache.camera_cache[0][0],
+                                    visibility.data(), map_dimensions );
+    cache_kernels::quadrant_max( &map_cache.lm[0][0], apparent_light.data(), map_dimensions );
+    cache_kernels::multiply( visibility.data(), apparent_light.data(), apparent_light.data(),
+                             map_dimensions );
+
+    const tripoint &player_pos = g->u.pos();
     tripoint p;
     p.z = zlev;
     int &x = p.x;
     int &y = p.y;
     for( x = 0; x < MAPSIZE_X; x++ ) {
         for( y = 0; y < MAPSIZE_Y; y++ ) {
-            lit_level ll = apparent_light_at( p, visibility_variables_cache );
+            const size_t i = x * MAPSIZE_Y + y;
+            const int dist = rl_dist( player_pos, p );
+            lit_level ll;
+            if( dist <= visibility_variables_cache.u_clairvoyance ) {
+                ll = LL_BRIGHT;
+            } else if( map_cache.transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID &&
+                       map_cache.vision_transparency_cache[x][y] <= LIGHT_TRANSPARENCY_SOLID ) {
+                ll = apparent_light_level( map_cache, p, dist, apparent_light_helper( map_cache, p ),
+                                           visibility_variables_cache );
+            } else {
+                const apparent_light_info a = {
+                    visibility[i] <= LIGHT_TRANSPARENCY_SOLID + 0.1, apparent_light[i]
+                };
+                ll = apparent_light_level( map_cache, p, dist, a, visibility_variables_cache );
+            }
             visibility_cache[x][y] = ll;
             sm_squares_seen[ x / SEEX ][ y / SEEY ] += ( ll == LL_BRIGHT || ll == LL_LIT );
         }
@@ -6069,7 +6175,11 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
         min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
         max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
     );
-    char cached = skew_vision_cache.get( key, -1 );
+    char cached;
+    {
+        std::lock_guard<std::mutex> lock( skew_vision_cache_mutex );
+        cached = skew_vision_cache.get( key, -1 );
+    }
     if( cached >= 0 ) {
         return cached > 0;
     }
@@ -6090,6 +6200,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
             }
             return true;
         } );
+        std::lock_guard<std::mutex> lock( skew_vision_cache_mutex );
         skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
         return visible;
     }
@@ -6123,6 +6234,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range, int &bres
         last_point = new_point;
         return true;
     } );
+    std::lock_guard<std::mutex> lock( skew_vision_cache_mutex );
     skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
     return visible;
 }
@@ -6567,6 +6679,10 @@ void map::shift( const point &sp )
 
     g->shift_destination_preview( point( -sp.x * SEEX, -sp.y * SEEY ) );
 
+    // Cached routes are in local coordinates
+    cached_routes->clear();
+    route_portal_graph->shift( sp );
+
     shift_traps( tripoint( sp, 0 ) );
 
     vehicle *remoteveh = g->remoteveh();
@@ -6589,6 +6705,8 @@ void map::shift( const point &sp )
         // Clear vehicle list and rebuild after shift
         clear_vehicle_cache( gridz );
         clear_vehicle_list( gridz );
+        get_cache( gridz ).light_contributions.clear();
+        get_cache( gridz ).scent_cache_dirty.set();
         shift_bitset_cache<MAPSIZE_X, SEEX>( get_cache( gridz ).map_memory_seen_cache, sp );
         shift_bitset_cache<MAPSIZE, 1>( get_cache( gridz ).field_cache, sp );
         if( sp.x >= 0 ) {
@@ -6663,6 +6781,33 @@ void map::shift( const point &sp )
     }
 }
 
+void map::prefetch_submaps( const point &direction, const int distance ) const
+{
+    if( direction == point_zero ) {
+        return;
+    }
+    const tripoint abs = get_abs_sub();
+    const rectangle loaded( abs.xy(), abs.xy() + point( my_MAPSIZE, my_MAPSIZE ) );
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs.z;
+    std::vector<tripoint> ahead;
+    for( int step = 1; step <= distance; step++ ) {
+        const point origin = abs.xy() + direction * step;
+        for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+            for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+                const point grid = origin + point( gridx, gridy );
+                if( loaded.contains_half_open( grid ) ) {
+                    continue;
+                }
+                for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+                    ahead.emplace_back( grid, gridz );
+                }
+            }
+        }
+    }
+    MAPBUFFER.prefetch( ahead );
+}
+
 void map::vertical_shift( const int newz )
 {
     if( !zlevels ) {
@@ -6793,7 +6938,8 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     set_seen_cache_dirty( grid.z );
     set_outside_cache_dirty( grid.z );
     set_floor_cache_dirty( grid.z );
-    set_pathfinding_cache_dirty( grid.z );
+    set_pathfinding_cache_dirty( tripoint( grid.x * SEEX, grid.y * SEEY, grid.z ) );
+    set_scent_cache_dirty( tripoint( grid.x * SEEX, grid.y * SEEY, grid.z ) );
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
         submaps_with_active_items.emplace( grid_abs_sub );
@@ -7209,6 +7355,7 @@ void map::actualize( const tripoint &grid )
 
     // the last time we touched the submap, is right now.
     tmpsub->last_touched = calendar::turn;
+    tmpsub->fields_updated = calendar::turn;
 }
 
 void map::add_roofs( const tripoint &grid )
@@ -7851,6 +7998,7 @@ void map::do_vehicle_caching( int z )
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    CATA_PROFILE_ZONE( "map::build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
@@ -8174,28 +8322,50 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
                           std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
                           const point &min, const point &max )
 {
-    auto reduce = TFLAG_REDUCE_SCENT;
-    auto block = TFLAG_NO_SCENT;
-    auto fill_values = [&]( const tripoint & gp, const submap * sm, const point & lp ) {
-        // We need to generate the x/y coordinates, because we can't get them "for free"
-        const int x = gp.x * SEEX + lp.x;
-        const int y = gp.y * SEEY + lp.y;
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            blocks_scent[x][y] = true;
-            reduces_scent[x][y] = false;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            blocks_scent[x][y] = false;
-            reduces_scent[x][y] = true;
-        } else {
-            blocks_scent[x][y] = false;
-            reduces_scent[x][y] = false;
-        }
+    level_cache &cache = get_cache( abs_sub.z );
+    if( cache.scent_cache_dirty.any() ) {
+        auto reduce = TFLAG_REDUCE_SCENT;
+        auto block = TFLAG_NO_SCENT;
+        auto fill_values = [&]( const tripoint & gp, const submap * sm, const point & lp ) {
+            // We need to generate the x/y coordinates, because we can't get them "for free"
+            const int x = gp.x * SEEX + lp.x;
+            const int y = gp.y * SEEY + lp.y;
+            if( sm->get_ter( lp ).obj().has_flag( block ) ) {
+                cache.scent_blocked_cache[x][y] = true;
+                cache.scent_reduced_cache[x][y] = false;
+            } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
+                       sm->get_furn( lp ).obj().has_flag( reduce ) ) {
+                cache.scent_blocked_cache[x][y] = false;
+                cache.scent_reduced_cache[x][y] = true;
+            } else {
+                cache.scent_blocked_cache[x][y] = false;
+                cache.scent_reduced_cache[x][y] = false;
+            }
 
-        return ITER_CONTINUE;
-    };
+            return ITER_CONTINUE;
+        };
 
-    function_over( tripoint( min, abs_sub.z ), tripoint( max, abs_sub.z ), fill_values );
+        for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
+            for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+                if( cache.scent_cache_dirty[smx * MAPSIZE + smy] ) {
+                    const tripoint sm_min( smx * SEEX, smy * SEEY, abs_sub.z );
+                    function_over( sm_min, sm_min + point( SEEX - 1, SEEY - 1 ), fill_values );
+                }
+            }
+        }
+        cache.scent_cache_dirty.reset();
+    }
+
+    for( int x = std::max( min.x, 0 ); x <= std::min( max.x, MAPSIZE_X - 1 ); ++x ) {
+        const int from = std::max( min.y, 0 );
+        const int to = std::min( max.y, MAPSIZE_Y - 1 ) + 1;
+        if( from < to ) {
+            std::copy( &cache.scent_blocked_cache[x][from], &cache.scent_blocked_cache[x][to],
+                       &blocks_scent[x][from] );
+            std::copy( &cache.scent_reduced_cache[x][from], &cache.scent_reduced_cache[x][to],
+                       &reduces_scent[x][from] );
+        }
+    }
 
     const rectangle local_bounds( min, max );
 
@@ -8358,6 +8528,8 @@ level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
     transparency_cache_dirty.set();
+    lightmap_dirty.set();
+    scent_cache_dirty.set();
     outside_cache_dirty = true;
     floor_cache_dirty = false;
     constexpr four_quadrants four_zeros( 0.0f );
@@ -8373,6 +8545,8 @@ level_cache::level_cache()
     std::fill_n( &visibility_cache[0][0], map_dimensions, LL_DARK );
     veh_in_active_range = false;
     std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
+    std::fill_n( &scent_blocked_cache[0][0], map_dimensions, false );
+    std::fill_n( &scent_reduced_cache[0][0], map_dimensions, false );
 }
 
 pathfinding_cache::pathfinding_cache()
@@ -8391,7 +8565,38 @@ void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
+        cached_routes->invalidate( zlev );
+        route_portal_graph->invalidate( zlev );
+    }
+}
+
+void map::clear_route_cache()
+{
+    cached_routes->clear();
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        set_pathfinding_cache_dirty( p, p );
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &min, const tripoint &max )
+{
+    const tripoint clamped_min( std::max( min.x, 0 ), std::max( min.y, 0 ),
+                                std::max( min.z, -OVERMAP_DEPTH ) );
+    const tripoint clamped_max( std::min( max.x, MAPSIZE_X - 1 ), std::min( max.y, MAPSIZE_Y - 1 ),
+                                std::min( max.z, OVERMAP_HEIGHT ) );
+    if( clamped_min.x > clamped_max.x || clamped_min.y > clamped_max.y ||
+        clamped_min.z > clamped_max.z ) {
+        return;
+    }
+    for( int z = clamped_min.z; z <= clamped_max.z; z++ ) {
+        get_pathfinding_cache( z ).dirty = true;
     }
+    cached_routes->invalidate( clamped_min, clamped_max );
+    route_portal_graph->invalidate( clamped_min, clamped_max );
 }
 
 const pathfinding_cache &map::get_pathfinding_cache_ref( int zlev ) const
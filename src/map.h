@@ -84,9 +84,14 @@ struct wrapped_vehicle {
 using VehicleList = std::vector<wrapped_vehicle>;
 class map;
 
+enum pf_special : int;
 enum ter_bitflags : int;
+class route_cache;
+class submap_portals;
+struct portal_cluster;
 struct pathfinding_cache;
 struct pathfinding_settings;
+struct route_step;
 template<typename T>
 struct weighted_int_list;
 
@@ -264,6 +269,34 @@ struct drawsq_params {
         //@}
 };
 
+/**
+ * Light cast by a single light source during @ref map::generate_lightmap.
+ * These are kept between calls, so a source that didn't change and whose light doesn't reach
+ * any submap with changed transparency doesn't have to be cast again.
+ */
+struct light_contribution {
+    enum class source_type : int {
+        point,
+        directional,
+        arc,
+    };
+    source_type type = source_type::point;
+    tripoint pos;
+    float luminance = 0.0f;
+    // Direction of directional lights and arcs
+    int angle = 0;
+    // Width of arcs, or the directions a point light is cast into
+    int spread = 0;
+
+    // Area reached by the light, half-open
+    point min;
+    point max;
+    // Light over that area, column by column
+    std::vector<four_quadrants> light;
+    // Brightness of the source tile itself, see level_cache::sm
+    float source_light = 0.0f;
+};
+
 struct level_cache {
     // Zeros all relevant values
     level_cache();
@@ -279,6 +312,21 @@ struct level_cache {
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
     // This is only valid for the duration of generate_lightmap
     float light_source_buffer[MAPSIZE_X][MAPSIZE_Y];
+    // Light cast by each source on the last call to generate_lightmap
+    std::vector<light_contribution> light_contributions;
+    // Contributions from the previous call that are still valid and may be reused.
+    // This is only valid for the duration of generate_lightmap
+    std::vector<light_contribution> reusable_light_contributions;
+    // New sources waiting to be cast in parallel, see map::cast_pending_light
+    std::vector<light_contribution> pending_light_contributions;
+    // Submaps whose transparency changed since the last call to generate_lightmap
+    std::bitset<MAPSIZE *MAPSIZE> lightmap_dirty;
+
+    // Scent flags of terrain and furniture, vehicles are added by map::scent_blockers
+    bool scent_blocked_cache[MAPSIZE_X][MAPSIZE_Y];
+    bool scent_reduced_cache[MAPSIZE_X][MAPSIZE_Y];
+    // Submaps whose scent flags need to be looked up again
+    std::bitset<MAPSIZE *MAPSIZE> scent_cache_dirty;
 
     // if false, means tile is under the roof ("inside"), true means tile is "outside"
     // "inside" tiles are protected from sun, rain, etc. (see "INDOORS" flag)
@@ -412,7 +460,24 @@ class map
             }
         }
 
+        // p is in local coords ("ms")
+        void set_scent_cache_dirty( const tripoint &p ) {
+            if( inbounds( p ) ) {
+                const tripoint smp = ms_to_sm_copy( p );
+                get_cache( smp.z ).scent_cache_dirty.set( smp.x * MAPSIZE + smp.y );
+            }
+        }
+
         void set_pathfinding_cache_dirty( int zlev );
+        // more granular version of the pathfinding cache invalidation, also keeps
+        // cached routes that don't go near p
+        // p is in local coords ("ms")
+        void set_pathfinding_cache_dirty( const tripoint &p );
+        // same for every tile in the box [min, max], such as the parts of a vehicle
+        void set_pathfinding_cache_dirty( const tripoint &min, const tripoint &max );
+        // Drops all routes and flow fields, which are only trusted for a while. Needed when
+        // the time is set back, they would look current for longer.
+        void clear_route_cache();
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p ) {
@@ -467,6 +532,9 @@ class map
          * @param cache Currently cached visibility parameters
          */
         lit_level apparent_light_at( const tripoint &p, const visibility_variables &cache ) const;
+        /** The part of apparent_light_at that follows clairvoyance, @p dist is the distance to the player */
+        static lit_level apparent_light_level( const level_cache &map_cache, const tripoint &p, int dist,
+                                               const apparent_light_info &a, const visibility_variables &cache );
         visibility_type get_visibility( lit_level ll,
                                         const visibility_variables &cache ) const;
 
@@ -526,6 +594,11 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point &s );
+        /**
+         * Reads ahead the submaps that shifting the map by @p direction up to @p distance
+         * times would load, see @ref mapbuffer::prefetch.
+         */
+        void prefetch_submaps( const point &direction, int distance ) const;
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -699,6 +772,41 @@ class map
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
         const std::set<tripoint> &pre_closed = {{ }} ) const;
+    private:
+        /** A* search for @ref route, limited to the box [min, max] */
+        std::vector<tripoint> route_search( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+                                            const std::set<tripoint> &pre_closed,
+                                            const tripoint &min, const tripoint &max ) const;
+        /**
+         * Route from @p f along a flow field toward @p t, built if there is enough demand.
+         * Empty if the route would leave the box [min, max] that @ref route_search is limited to.
+         */
+        std::vector<tripoint> route_flow( const tripoint &f, const tripoint &t,
+                                          const pathfinding_settings &settings,
+                                          const tripoint &min, const tripoint &max ) const;
+        /**
+         * Long route planned over @ref submap_portals and refined submap by submap. Sets
+         * @p min and @p max to the box the refining searches covered.
+         */
+        std::vector<tripoint> route_portals( const tripoint &f, const tripoint &t,
+                                             const pathfinding_settings &settings,
+                                             const std::set<tripoint> &pre_closed,
+                                             tripoint &min, tripoint &max ) const;
+        /** Rebuilds the portals of the cluster on submap @p grid */
+        void build_portal_cluster( portal_cluster &cluster, const tripoint &grid,
+                                   const pathfinding_settings &settings ) const;
+        /**
+         * Costs of the cheapest routes from @p from to every tile of its submap, by position
+         * inside the submap, negative if unreachable. When @p reverse is set, costs of routes
+         * from every tile to @p from instead.
+         */
+        std::vector<int> route_submap_costs( const tripoint &from, bool reverse,
+                                             const pathfinding_settings &settings ) const;
+        /** Cost of a route stepping from @p cur onto the adjacent @p p */
+        route_step route_step_cost( const tripoint &cur, const tripoint &p, pf_special p_special,
+                                    const pathfinding_settings &settings ) const;
+    public:
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -916,6 +1024,11 @@ class map
         bool has_flag_ter_or_furn( const std::string &flag, const point &p ) const {
             return has_flag_ter_or_furn( flag, tripoint( p, abs_sub.z ) );
         }
+        // Same as the above for flags with their index looked up, see ter_furn_flag
+        bool has_flag( const ter_furn_flag &flag, const tripoint &p ) const;
+        bool has_flag_ter( const ter_furn_flag &flag, const tripoint &p ) const;
+        bool has_flag_furn( const ter_furn_flag &flag, const tripoint &p ) const;
+        bool has_flag_ter_or_furn( const ter_furn_flag &flag, const tripoint &p ) const;
         // Fast "oh hai it's update_scent/lightmap/draw/monmove/self/etc again, what about this one" flag checking
         // Checks terrain, furniture and vehicles
         bool has_flag( ter_bitflags flag, const tripoint &p ) const;
@@ -1312,7 +1425,12 @@ class map
         void create_burnproducts( const tripoint &p, const item &fuel, const units::mass &burned_mass );
         // See fields.cpp
         void process_fields();
-        void process_fields_in_submap( submap *current_submap, const tripoint &submap_pos );
+        /**
+         * Processes the fields of a submap once. When @p turns is more than one, fields also
+         * age and decay by the turns that were skipped.
+         */
+        void process_fields_in_submap( submap *current_submap, const tripoint &submap_pos,
+                                       int turns = 1 );
         /**
          * Apply field effects to the creature when it's on a square with fields.
          */
@@ -1419,7 +1537,8 @@ class map
         // Scent propagation helpers
         /**
          * Build the map of scent-resistant tiles.
-         * Should be way faster than if done in `game.cpp` using public map functions.
+         * Terrain and furniture flags are cached, only submaps changed since the last call are
+         * looked up again.
          */
         void scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
                              std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
@@ -1833,6 +1952,18 @@ class map
         void apply_light_arc( const tripoint &p, int angle, float luminance, int wideangle = 30 );
         void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
                               const tripoint &s, const tripoint &e, float luminance );
+        // Adds the light of @p source to the lightmap, reusing the light it cast on the
+        // previous call to generate_lightmap if possible
+        void apply_light_contribution( light_contribution &&source );
+        // Casts the sources that apply_light_contribution left for the worker pool
+        void cast_pending_light( level_cache &cache );
+        // Casts the light of @p source and stores it in @p source
+        void cast_light_contribution( light_contribution &source );
+        static void add_light_contribution( level_cache &cache, light_contribution &&source );
+        // These cast into a scratch buffer, see apply_light_contribution
+        void cast_light_source( const tripoint &p, float luminance, int directions );
+        void cast_directional_light( const tripoint &p, int direction, float luminance );
+        void cast_light_arc( const tripoint &p, int angle, float luminance, int wideangle );
         void add_light_from_items( const tripoint &p, item_stack::iterator begin,
                                    item_stack::iterator end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks );
@@ -1901,6 +2032,16 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        /**
+         * Routes recently found by @ref route, see @ref route_cache
+         * Like pathfinding_caches, it is filled in by the const @ref route, so routes must not
+         * be searched from several threads at once.
+         */
+        mutable std::unique_ptr<route_cache> cached_routes;
+        /**
+         * Abstract graph used by @ref route for long routes
+         */
+        mutable std::unique_ptr<submap_portals> route_portal_graph;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -5,13 +5,16 @@
 #include <functional>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "async_file_writer.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
 #include "distribution_grid.h"
+#include "file_prefetcher.h"
 #include "filesystem.h"
 #include "fstream_utils.h"
 #include "game.h"
@@ -39,6 +42,14 @@ static std::string find_dirname( const tripoint &om_addr )
 
 mapbuffer MAPBUFFER;
 
+// Division rounding toward negative infinity, with the matching non-negative remainder
+static int divide( int v, int m, int &r )
+{
+    const int result = v >= 0 ? v / m : ( v - m + 1 ) / m;
+    r = v - result * m;
+    return result;
+}
+
 mapbuffer::mapbuffer() = default;
 
 mapbuffer::~mapbuffer()
@@ -46,21 +57,110 @@ mapbuffer::~mapbuffer()
     reset();
 }
 
+mapbuffer::const_iterator::const_iterator( chunk_map_t::const_iterator it,
+        chunk_map_t::const_iterator end ) : it( it ), end( end )
+{
+    skip_empty();
+}
+
+mapbuffer::const_iterator::value_type mapbuffer::const_iterator::operator*() const
+{
+    const tripoint &chunk_pos = it->first;
+    const tripoint pos( chunk_pos.x * chunk_size + static_cast<int>( index ) / chunk_size,
+                        chunk_pos.y * chunk_size + static_cast<int>( index ) % chunk_size, chunk_pos.z );
+    return value_type( pos, it->second->submaps[index] );
+}
+
+mapbuffer::const_iterator &mapbuffer::const_iterator::operator++()
+{
+    index++;
+    skip_empty();
+    return *this;
+}
+
+void mapbuffer::const_iterator::skip_empty()
+{
+    while( it != end ) {
+        const auto &slots = it->second->submaps;
+        while( index < slots.size() && slots[index] == nullptr ) {
+            index++;
+        }
+        if( index < slots.size() ) {
+            return;
+        }
+        ++it;
+        index = 0;
+    }
+}
+
+submap **mapbuffer::find_slot( const tripoint &p )
+{
+    point local;
+    const tripoint chunk_pos( divide( p.x, chunk_size, local.x ), divide( p.y, chunk_size, local.y ),
+                              p.z );
+    if( last_chunk == nullptr || last_chunk_pos != chunk_pos ) {
+        const auto iter = chunks.find( chunk_pos );
+        if( iter == chunks.end() ) {
+            return nullptr;
+        }
+        last_chunk_pos = chunk_pos;
+        last_chunk = iter->second.get();
+    }
+    return &last_chunk->submaps[local.x * chunk_size + local.y];
+}
+
+submap *&mapbuffer::get_slot( const tripoint &p )
+{
+    point local;
+    const tripoint chunk_pos( divide( p.x, chunk_size, local.x ), divide( p.y, chunk_size, local.y ),
+                              p.z );
+    if( last_chunk == nullptr || last_chunk_pos != chunk_pos ) {
+        std::unique_ptr<chunk> &found = chunks[chunk_pos];
+        if( !found ) {
+            found = std::make_unique<chunk>();
+        }
+        last_chunk_pos = chunk_pos;
+        last_chunk = found.get();
+    }
+    return last_chunk->submaps[local.x * chunk_size + local.y];
+}
+
+void mapbuffer::wait_for_saves()
+{
+    if( !writer ) {
+        return;
+    }
+    for( const std::string &error : writer->wait() ) {
+        debugmsg( "%s", error );
+    }
+}
+
 void mapbuffer::reset()
 {
-    for( auto &elem : submaps ) {
-        delete elem.second;
+    wait_for_saves();
+    if( prefetcher ) {
+        prefetcher->clear();
+    }
+    for( auto &elem : chunks ) {
+        for( submap *sm : elem.second->submaps ) {
+            delete sm;
+        }
     }
-    submaps.clear();
+    chunks.clear();
+    num_submaps = 0;
+    last_chunk = nullptr;
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 {
-    if( submaps.count( p ) != 0 ) {
+    submap *&slot = get_slot( p );
+    if( slot != nullptr ) {
         return false;
     }
 
-    submaps[p] = sm;
+    slot = sm;
+    last_chunk->count++;
+    num_submaps++;
 
     return true;
 }
@@ -76,19 +176,24 @@ bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
 
 void mapbuffer::remove_submap( tripoint addr )
 {
-    auto m_target = submaps.find( addr );
-    if( m_target == submaps.end() ) {
+    submap **slot = find_slot( addr );
+    if( slot == nullptr || *slot == nullptr ) {
         debugmsg( "Tried to remove non-existing submap %s", addr.to_string() );
         return;
     }
-    delete m_target->second;
-    submaps.erase( m_target );
+    delete *slot;
+    *slot = nullptr;
+    num_submaps--;
+    if( --last_chunk->count == 0 ) {
+        chunks.erase( last_chunk_pos );
+        last_chunk = nullptr;
+    }
 }
 
 submap *mapbuffer::lookup_submap( const tripoint &p )
 {
-    const auto iter = submaps.find( p );
-    if( iter == submaps.end() ) {
+    submap **slot = find_slot( p );
+    if( slot == nullptr || *slot == nullptr ) {
         try {
             return unserialize_submaps( p );
         } catch( const std::exception &err ) {
@@ -97,15 +202,46 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
-    return iter->second;
+    return *slot;
+}
+
+void mapbuffer::prefetch( const std::vector<tripoint> &submaps )
+{
+    if( !prefetcher ) {
+        prefetcher = std::make_unique<file_prefetcher>();
+    }
+    std::set<tripoint> quads;
+    for( const tripoint &p : submaps ) {
+        submap **slot = find_slot( p );
+        if( slot != nullptr && *slot != nullptr ) {
+            continue;
+        }
+        const tripoint om_addr = sm_to_omt_copy( p );
+        if( !quads.insert( om_addr ).second ) {
+            continue;
+        }
+        const std::string quad_path = find_quad_path( find_dirname( om_addr ), om_addr );
+        if( writer && writer->is_pending( quad_path ) ) {
+            // Will be read from the queued contents anyway
+            continue;
+        }
+        prefetcher->request( quad_path );
+    }
 }
 
 void mapbuffer::save( bool delete_after_save )
 {
+    if( !writer ) {
+        writer = std::make_unique<async_file_writer>();
+    }
+    // Failures of earlier saves only show up now, their files are written again with this one
+    const std::vector<std::string> errors = writer->take_errors();
+    writer->retry_failed();
+
     assure_dir_exist( g->get_world_base_save_path() + "/maps" );
 
     int num_saved_submaps = 0;
-    int num_total_submaps = submaps.size();
+    int num_total_submaps = size();
 
     const tripoint map_origin = sm_to_omt_copy( g->m.get_abs_sub() );
     const bool map_has_zlevels = g != nullptr && g->m.has_zlevels();
@@ -118,7 +254,7 @@ void mapbuffer::save( bool delete_after_save )
     static constexpr std::chrono::milliseconds update_interval( 500 );
     auto last_update = std::chrono::steady_clock::now();
 
-    for( auto &elem : submaps ) {
+    for( const auto &elem : *this ) {
         auto now = std::chrono::steady_clock::now();
         if( last_update + update_interval < now ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
@@ -154,11 +290,16 @@ void mapbuffer::save( bool delete_after_save )
                    om_addr.y > map_origin.y + HALF_MAPSIZE );
         num_saved_submaps += 4;
     }
+
+    // The files are still being written, until then they're read from the queued contents
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
 
     get_distribution_grid_tracker().on_saved();
+    if( !errors.empty() ) {
+        throw std::runtime_error( enumerate_as_string( errors, enumeration_conjunction::none ) );
+    }
 }
 
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
@@ -178,8 +319,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
-        if( sm != nullptr && !sm->is_uniform ) {
+        submap **slot = find_slot( submap_addr );
+        if( slot != nullptr && *slot != nullptr && !( *slot )->is_uniform ) {
             all_uniform = false;
         }
     }
@@ -188,7 +329,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                submap **slot = find_slot( submap_addr );
+                if( slot != nullptr && *slot != nullptr ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -199,19 +341,16 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 
     // Don't create the directory if it would be empty
     assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
+    std::ostringstream fout;
+    {
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr];
-
-            if( sm == nullptr ) {
+            submap **slot = find_slot( submap_addr );
+            if( slot == nullptr || *slot == nullptr ) {
                 continue;
             }
+            submap *sm = *slot;
 
             jsout.start_object();
 
@@ -234,7 +373,12 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         }
 
         jsout.end_array();
-    } );
+    }
+    if( prefetcher ) {
+        // Anything read ahead is outdated now
+        prefetcher->discard( filename );
+    }
+    writer->queue( filename, fout.str() );
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -258,17 +402,28 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         }
     }
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+    std::string contents;
+    bool exists = true;
+    if( writer && writer->pending_contents( find_quad_path( dirname, om_addr ), contents ) ) {
+        // Saved recently and not written yet, the file on disk is outdated
+        JsonIn jsin( contents, quad_path );
+        deserialize( jsin );
+    } else if( prefetcher &&
+               prefetcher->take( find_quad_path( dirname, om_addr ), contents, exists ) && exists ) {
+        JsonIn jsin( contents, quad_path );
+        deserialize( jsin );
+    } else if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this,
+               std::placeholders::_1 ) ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
-    if( submaps.count( p ) == 0 ) {
+    submap **slot = find_slot( p );
+    if( slot == nullptr || *slot == nullptr ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
                   quad_path, p.x, p.y, p.z );
         return nullptr;
     }
-    return submaps[ p ];
+    return *slot;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
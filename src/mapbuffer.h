@@ -2,13 +2,20 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "point.h"
 
+class async_file_writer;
+class file_prefetcher;
 class submap;
 class JsonIn;
 
@@ -22,12 +29,22 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * The files are written on a background thread, the save returns once they're all
+         * queued. Submaps are read from the queued contents until their files are written.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * @throw std::exception if files of earlier saves could not be written. They are
+         * queued again, this save still completes.
          **/
         void save( bool delete_after_save = false );
 
-        /** Delete all buffered submaps. **/
+        /**
+         * Blocks until the files of all saves so far are written. Needed before the save
+         * directory goes away or another world is loaded. Failed writes show a debug message.
+         **/
+        void wait_for_saves();
+
+        /** Delete all buffered submaps, after waiting for their files to be written. **/
         void reset();
 
         /** Add a new submap to the buffer.
@@ -54,27 +71,96 @@ class mapbuffer
          */
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * Starts reading the files of the given submaps in the background, so that a later
+         * @ref lookup_submap doesn't have to wait for the disk. Submaps that are already
+         * loaded are skipped.
+         * @param submaps Absolute positions in submap coordinates.
+         */
+        void prefetch( const std::vector<tripoint> &submaps );
+
+        /**
+         * Removes and deletes the submap at @p addr.
+         * Only for submaps that aren't loaded into a map, or this will crash the game.
+         */
+        void remove_submap( tripoint addr );
+
+        /** Number of submaps currently in the buffer. */
+        size_t size() const {
+            return num_submaps;
+        }
+
     private:
-        using submap_map_t = std::map<tripoint, submap *>;
+        // Submaps are grouped into square chunks of this many submaps per side, a dense grid
+        // per chunk turns most lookups into a single hash probe and an array access.
+        static constexpr int chunk_size = 32;
+        struct chunk {
+            std::array<submap *, chunk_size * chunk_size> submaps;
+            int count = 0;
+
+            chunk() {
+                submaps.fill( nullptr );
+            }
+        };
+        using chunk_map_t = std::unordered_map<tripoint, std::unique_ptr<chunk>>;
 
     public:
-        inline submap_map_t::iterator begin() {
-            return submaps.begin();
+        /** Iterates over (position, submap) pairs of all stored submaps, in no particular order. */
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::pair<tripoint, submap *>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const value_type *;
+                using reference = value_type;
+
+                const_iterator( chunk_map_t::const_iterator it, chunk_map_t::const_iterator end );
+
+                value_type operator*() const;
+                const_iterator &operator++();
+                bool operator==( const const_iterator &rhs ) const {
+                    return it == rhs.it && index == rhs.index;
+                }
+                bool operator!=( const const_iterator &rhs ) const {
+                    return !( *this == rhs );
+                }
+
+            private:
+                // Moves forward to the next occupied slot, starting at the current one
+                void skip_empty();
+
+                chunk_map_t::const_iterator it;
+                chunk_map_t::const_iterator end;
+                size_t index = 0;
+        };
+
+        const_iterator begin() const {
+            return const_iterator( chunks.begin(), chunks.end() );
         }
-        inline submap_map_t::iterator end() {
-            return submaps.end();
+        const_iterator end() const {
+            return const_iterator( chunks.end(), chunks.end() );
         }
 
     private:
-        // There's a very good reason this is private,
-        // if not handled carefully, this can erase in-use submaps and crash the game.
-        void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
         void save_quad( const std::string &dirname, const std::string &filename,
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
-        submap_map_t submaps;
+        /** Returns the slot for the submap at @p p, nullptr if its chunk doesn't exist yet. */
+        submap **find_slot( const tripoint &p );
+        /** Like @ref find_slot, but creates the chunk if needed. */
+        submap *&get_slot( const tripoint &p );
+
+        // Created by the first save() and kept, so saving never waits for the disk
+        std::unique_ptr<async_file_writer> writer;
+        std::unique_ptr<file_prefetcher> prefetcher;
+        chunk_map_t chunks;
+        size_t num_submaps = 0;
+        // Consecutive lookups tend to hit the same chunk
+        tripoint last_chunk_pos;
+        chunk *last_chunk = nullptr;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -463,9 +463,38 @@ void load_terrain( const JsonObject &jo, const std::string &src )
     terrain_data.load( jo, src );
 }
 
+// Only grows, indices stay valid when data is reloaded. Not a plain static, the ter_furn_flag
+// constants of other files use it while they are initialized.
+static std::unordered_map<std::string, int> &flag_indices()
+{
+    static std::unordered_map<std::string, int> indices;
+    return indices;
+}
+
+static int add_flag_index( const std::string &flag )
+{
+    std::unordered_map<std::string, int> &indices = flag_indices();
+    return indices.emplace( flag, static_cast<int>( indices.size() ) ).first->second;
+}
+
+ter_furn_flag::ter_furn_flag( const std::string &flag ) : index( add_flag_index( flag ) )
+{
+}
+
+int map_data_common_t::flag_index( const std::string &flag )
+{
+    const auto it = flag_indices().find( flag );
+    return it != flag_indices().end() ? it->second : -1;
+}
+
 void map_data_common_t::set_flag( const std::string &flag )
 {
     flags.insert( flag );
+    const size_t index = add_flag_index( flag );
+    if( flag_bits.size() <= index ) {
+        flag_bits.resize( index + 1, false );
+    }
+    flag_bits[index] = true;
     const auto it = ter_bitflags_map.find( flag );
     if( it != ter_bitflags_map.end() ) {
         bitflags.set( it->second );
@@ -15,6 +15,7 @@
 
 std::unordered_map< mfaction_str_id, mfaction_id > faction_map;
 std::vector< monfaction > faction_list;
+static mfaction_id player_faction_id;
 
 void add_to_attitude_map( const std::set< std::string > &keys, mfaction_att_map &map,
                           mf_attitude value );
@@ -121,10 +122,16 @@ mf_attitude monfaction::attitude( const mfaction_id &other ) const
     return MFA_FRIENDLY;
 }
 
+const mfaction_id &monfactions::player_faction()
+{
+    return player_faction_id;
+}
+
 void monfactions::reset()
 {
     faction_list.clear();
     faction_map.clear();
+    player_faction_id = mfaction_id( 0 );
 }
 
 void monfactions::finalize()
@@ -134,6 +141,11 @@ void monfactions::finalize()
         return;
     }
 
+    static const mfaction_str_id playerfaction( "player" );
+    if( playerfaction.is_valid() ) {
+        player_faction_id = playerfaction.id();
+    }
+
     // Create a tree of faction dependence
     std::multimap< mfaction_id, mfaction_id > child_map;
     std::set< mfaction_id > unloaded; // To check if cycles exist
@@ -23,6 +23,11 @@ void reset();
 void finalize();
 void load_monster_faction( const JsonObject &jo );
 mfaction_id get_or_add_faction( const mfaction_str_id &id );
+/**
+ * Faction of the monsters that are friendly to the player. Looked up once the factions are
+ * finalized, so it can be read from worker threads.
+ */
+const mfaction_id &player_faction();
 } // namespace monfactions
 
 class monfaction
@@ -22,6 +22,7 @@
 #include "character_id.h"
 #include "clzones.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "dispersion.h"
@@ -445,7 +446,11 @@ void npc::assess_danger()
         }
     }
 
-    for( const monster &critter : g->all_monsters() ) {
+    // Monsters out of sight are neither threats nor allies worth accounting for
+    const int search_range = max_sees_range();
+    for( const monster *critter_ptr : g->critter_tracker->find_in_radius( pos(), search_range,
+            search_range ) ) {
+        const monster &critter = *critter_ptr;
         auto att = critter.attitude_to( *this );
         if( att == A_FRIENDLY ) {
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
@@ -2152,6 +2152,21 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "PARALLEL_SHADOWCASTING", "debug", translate_marker( "Parallel shadowcasting" ),
+         translate_marker( "If true, light and field of vision are calculated on several threads.  Faster on processors with many cores." ),
+         false
+       );
+
+    add( "FIELD_IDLE_INTERVAL", "debug", translate_marker( "Idle field interval" ),
+         translate_marker( "Fields far from any creature are processed only every this many turns, their decay is caught up when they are.  1 processes every field every turn.  Higher is faster during large fires." ),
+         1, 10, 1
+       );
+
+    add( "PARALLEL_MONSTER_PLANNING", "debug", translate_marker( "Parallel monster planning" ),
+         translate_marker( "If true, monsters choose their targets on several threads before they move.  Faster with many monsters around." ),
+         false
+       );
+
     add( "ENABLE_EVENTS", "debug", translate_marker( "Event bus system" ),
          translate_marker( "If false, achievements and some Magiclysm functionality won't work, but performance will be better." ),
          true
@@ -3279,6 +3294,9 @@ void options_manager::cache_to_globals()
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
     fov_3d = ::get_option<bool>( "FOV_3D" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
+    parallel_shadowcasting = ::get_option<bool>( "PARALLEL_SHADOWCASTING" );
+    parallel_monster_planning = ::get_option<bool>( "PARALLEL_MONSTER_PLANNING" );
+    field_idle_interval = ::get_option<int>( "FIELD_IDLE_INTERVAL" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
 #if defined(SDL_SOUND)
     sounds::sound_enabled = ::get_option<bool>( "SOUND_ENABLED" );
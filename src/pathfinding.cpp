@@ -2,8 +2,11 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <functional>
 #include <queue>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <array>
 #include <memory>
 #include <utility>
@@ -13,6 +16,7 @@
 #include "coordinates.h"
 #include "debug.h"
 #include "map.h"
+#include "map_iterator.h"
 #include "mapdata.h"
 #include "optional.h"
 #include "submap.h"
@@ -37,43 +41,118 @@ constexpr int flat_index( const tripoint &p )
 }
 
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// Nodes are stamped with the search that last touched them, so the layer can be
+// reused by the next search without clearing it first.
 struct path_data_layer {
     // State is accessed way more often than all other values here
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
+    std::array< unsigned int, MAPSIZE_X *MAPSIZE_Y > generation;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
+    // Generation of the search currently using this layer
+    unsigned int current = 0;
 
-    void init( const point &min, const point &max ) {
-        tripoint p;
-        for( p.x = min.x; p.x <= max.x; p.x++ ) {
-            for( p.y = min.y; p.y <= max.y; p.y++ ) {
-                const int ind = flat_index( p );
-                state[ind] = ASL_NONE; // Mark as unvisited
+    astar_state get_state( const int index ) const {
+        return generation[index] == current ? state[index] : ASL_NONE;
+    }
+
+    void set_state( const int index, const astar_state new_state ) {
+        generation[index] = current;
+        state[index] = new_state;
+    }
+};
+
+// Binary heaps spend most of their time swapping between distant levels,
+// a wider heap is shallower and keeps siblings in the same cache line.
+class path_open_set
+{
+    private:
+        static constexpr size_t arity = 4;
+        std::vector< std::pair<int, tripoint> > heap;
+
+    public:
+        void clear() {
+            heap.clear();
+        }
+
+        bool empty() const {
+            return heap.empty();
+        }
+
+        void push( const int score, const tripoint &p ) {
+            size_t i = heap.size();
+            heap.emplace_back( score, p );
+            while( i > 0 ) {
+                const size_t up = ( i - 1 ) / arity;
+                if( heap[up].first <= score ) {
+                    break;
+                }
+                heap[i] = heap[up];
+                i = up;
             }
+            heap[i] = std::make_pair( score, p );
+        }
+
+        tripoint pop() {
+            const tripoint top = heap.front().second;
+            const std::pair<int, tripoint> last = heap.back();
+            heap.pop_back();
+            const size_t size = heap.size();
+            if( size == 0 ) {
+                return top;
+            }
+            size_t i = 0;
+            while( true ) {
+                const size_t first_child = i * arity + 1;
+                if( first_child >= size ) {
+                    break;
+                }
+                const size_t last_child = std::min( first_child + arity, size );
+                size_t best = first_child;
+                for( size_t c = first_child + 1; c < last_child; c++ ) {
+                    if( heap[c].first < heap[best].first ) {
+                        best = c;
+                    }
+                }
+                if( heap[best].first >= last.first ) {
+                    break;
+                }
+                heap[i] = heap[best];
+                i = best;
+            }
+            heap[i] = last;
+            return top;
         }
-    }
 };
 
+// Search state reused between calls to map::route, see @ref get_pathfinder
 struct pathfinder {
-    point min;
-    point max;
-    pathfinder( const point &_min, const point &_max ) :
-        min( _min ), max( _max ) {
-    }
-
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    path_open_set open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    unsigned int generation = 0;
+
+    // Invalidates all node data from the previous search
+    void reset() {
+        open.clear();
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around, stamps from ancient searches could look current again
+            for( std::unique_ptr< path_data_layer > &layer : path_data ) {
+                if( layer != nullptr ) {
+                    layer->generation.fill( 0 );
+                }
+            }
+            generation = 1;
+        }
+    }
 
     path_data_layer &get_layer( const int z ) {
         std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
+        ptr->current = generation;
         return *ptr;
     }
 
@@ -82,39 +161,47 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        return open.pop();
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.get_state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) ||
+            state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.push( score, to );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p );
-        layer.state[index] = ASL_CLOSED;
+        layer.set_state( index, ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p );
-        layer.state[index] = ASL_NONE;
+        layer.set_state( index, ASL_NONE );
     }
 };
 
+// Layers are large and expensive to allocate, so each thread keeps its own
+// pathfinder around and every search only bumps its generation.
+static pathfinder &get_pathfinder()
+{
+    static thread_local pathfinder pf;
+    pf.reset();
+    return pf;
+}
+
 // Modifies `t` to be a tile with `flag` in the overmap tile that `t` was originally on
 // return false if it could not find a suitable point
 template<ter_bitflags flag>
@@ -191,6 +278,367 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+bool pathfinding_settings::operator==( const pathfinding_settings &rhs ) const
+{
+    return bash_strength == rhs.bash_strength && max_dist == rhs.max_dist &&
+           max_length == rhs.max_length && climb_cost == rhs.climb_cost &&
+           allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+           allow_climb_stairs == rhs.allow_climb_stairs &&
+           avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp;
+}
+
+// Cached routes are only trusted for this long, some changes (damaged vehicle parts)
+// don't mark the pathfinding cache dirty.
+static constexpr time_duration route_cache_lifetime = 1_minutes;
+static constexpr size_t max_cached_routes = 128;
+// Requests toward the same target within a turn before it gets a flow field
+static constexpr int flow_field_demand = 3;
+static constexpr size_t max_flow_fields = 4;
+
+const std::vector<tripoint> *route_cache::find( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed )
+{
+    for( auto iter = routes.begin(); iter != routes.end(); ++iter ) {
+        if( iter->from != f || iter->to != t || iter->settings != settings ||
+            iter->pre_closed != pre_closed ) {
+            continue;
+        }
+        if( iter->created + route_cache_lifetime < calendar::turn ) {
+            routes.erase( iter );
+            return nullptr;
+        }
+        // Move to front, so the least recently used route is evicted first
+        routes.splice( routes.begin(), routes, iter );
+        return &routes.front().path;
+    }
+    return nullptr;
+}
+
+void route_cache::store( const tripoint &f, const tripoint &t,
+                         const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+                         const tripoint &min, const tripoint &max, const std::vector<tripoint> &path )
+{
+    routes.push_front( cached_route{ f, t, settings, pre_closed, min, max, calendar::turn, path } );
+    if( routes.size() > max_cached_routes ) {
+        routes.pop_back();
+    }
+}
+
+bool route_cache::wants_flow_field( const tripoint &t, const pathfinding_settings &settings )
+{
+    if( demands_turn != calendar::turn ) {
+        demands.clear();
+        demands_turn = calendar::turn;
+    }
+    for( route_demand &demand : demands ) {
+        if( demand.target == t && demand.settings == settings ) {
+            return ++demand.count >= flow_field_demand;
+        }
+    }
+    demands.push_back( route_demand{ t, settings, 1 } );
+    return false;
+}
+
+const route_cache::flow_field *route_cache::find_flow_field( const tripoint &t,
+        const pathfinding_settings &settings )
+{
+    for( auto iter = flow_fields.begin(); iter != flow_fields.end(); ) {
+        if( iter->created != calendar::turn ) {
+            iter = flow_fields.erase( iter );
+        } else if( iter->target == t && iter->settings == settings ) {
+            return &*iter;
+        } else {
+            ++iter;
+        }
+    }
+    return nullptr;
+}
+
+route_cache::flow_field &route_cache::add_flow_field( const tripoint &t,
+        const pathfinding_settings &settings )
+{
+    if( flow_fields.size() >= max_flow_fields ) {
+        flow_fields.pop_back();
+    }
+    flow_fields.push_front( flow_field() );
+    flow_field &field = flow_fields.front();
+    field.target = t;
+    field.settings = settings;
+    field.created = calendar::turn;
+    field.cost.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+    field.next.assign( MAPSIZE_X * MAPSIZE_Y, -1 );
+    return field;
+}
+
+void route_cache::invalidate( const int zlev )
+{
+    routes.remove_if( [zlev]( const cached_route & r ) {
+        return r.min.z <= zlev && zlev <= r.max.z;
+    } );
+    flow_fields.remove_if( [zlev]( const flow_field & field ) {
+        return field.target.z == zlev;
+    } );
+}
+
+void route_cache::invalidate( const tripoint &min, const tripoint &max )
+{
+    // A route only depends on the tiles its search could look at
+    routes.remove_if( [&]( const cached_route & r ) {
+        return r.min.z <= max.z && min.z <= r.max.z &&
+               r.min.x <= max.x && min.x <= r.max.x &&
+               r.min.y <= max.y && min.y <= r.max.y;
+    } );
+    // Flow fields cover the whole level
+    flow_fields.remove_if( [&]( const flow_field & field ) {
+        return min.z <= field.target.z && field.target.z <= max.z;
+    } );
+}
+
+void route_cache::clear()
+{
+    routes.clear();
+    flow_fields.clear();
+    demands.clear();
+}
+
+// Limited so that NPCs with many different settings don't keep rebuilding all of them
+static constexpr size_t max_portal_layers = 4;
+
+submap_portals::submap_portals( const int mapsize ) : mapsize( mapsize )
+{
+}
+
+int submap_portals::cluster_index( const point &p ) const
+{
+    return ( p.x / SEEX ) * mapsize + p.y / SEEY;
+}
+
+portal_layer &submap_portals::get_layer( const int zlev, const pathfinding_settings &settings )
+{
+    for( auto iter = layers.begin(); iter != layers.end(); ++iter ) {
+        if( iter->zlev == zlev && iter->settings == settings ) {
+            layers.splice( layers.begin(), layers, iter );
+            return layers.front();
+        }
+    }
+    if( layers.size() >= max_portal_layers ) {
+        layers.pop_back();
+    }
+    layers.emplace_front();
+    portal_layer &layer = layers.front();
+    layer.zlev = zlev;
+    layer.settings = settings;
+    layer.clusters.resize( mapsize * mapsize );
+    return layer;
+}
+
+void submap_portals::invalidate( const int zlev )
+{
+    for( portal_layer &layer : layers ) {
+        if( layer.zlev != zlev ) {
+            continue;
+        }
+        for( portal_cluster &cluster : layer.clusters ) {
+            cluster.dirty = true;
+        }
+    }
+}
+
+void submap_portals::invalidate( const tripoint &min, const tripoint &max )
+{
+    const point grid_min( min.x / SEEX, min.y / SEEY );
+    const point grid_max( max.x / SEEX, max.y / SEEY );
+    for( portal_layer &layer : layers ) {
+        if( layer.zlev < min.z || layer.zlev > max.z ) {
+            continue;
+        }
+        for( int x = grid_min.x; x <= grid_max.x; x++ ) {
+            for( int y = grid_min.y; y <= grid_max.y; y++ ) {
+                // Neighbours share the portals on the common edge
+                for( const point &offset : four_adjacent_offsets ) {
+                    const point neighbour = point( x, y ) + offset;
+                    if( neighbour.x >= 0 && neighbour.x < mapsize && neighbour.y >= 0 &&
+                        neighbour.y < mapsize ) {
+                        layer.clusters[neighbour.x * mapsize + neighbour.y].dirty = true;
+                    }
+                }
+                layer.clusters[x * mapsize + y].dirty = true;
+            }
+        }
+    }
+}
+
+void submap_portals::shift( const point &sp )
+{
+    const point offset( -sp.x * SEEX, -sp.y * SEEY );
+    const auto in_range = [this]( const point & grid ) {
+        return grid.x >= 0 && grid.x < mapsize && grid.y >= 0 && grid.y < mapsize;
+    };
+    for( portal_layer &layer : layers ) {
+        std::vector<portal_cluster> shifted( layer.clusters.size() );
+        for( int x = 0; x < mapsize; x++ ) {
+            for( int y = 0; y < mapsize; y++ ) {
+                const point old_grid = point( x, y ) + sp;
+                if( !in_range( old_grid ) ) {
+                    // Newly loaded submap
+                    continue;
+                }
+                portal_cluster &cluster = shifted[x * mapsize + y];
+                cluster = std::move( layer.clusters[old_grid.x * mapsize + old_grid.y] );
+                for( submap_portal &portal : cluster.portals ) {
+                    portal.pos += offset;
+                    portal.partner += offset;
+                }
+            }
+        }
+        // Edges toward the newly loaded submaps will get new portals
+        for( int x = 0; x < mapsize; x++ ) {
+            for( int y = 0; y < mapsize; y++ ) {
+                for( const point &off : four_adjacent_offsets ) {
+                    const point neighbour = point( x, y ) + off;
+                    if( in_range( neighbour ) && !in_range( neighbour + sp ) ) {
+                        shifted[x * mapsize + y].dirty = true;
+                    }
+                }
+            }
+        }
+        layer.clusters = std::move( shifted );
+    }
+}
+
+void submap_portals::clear()
+{
+    layers.clear();
+}
+
+static const pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+route_step map::route_step_cost( const tripoint &cur, const tripoint &p,
+                                 const pf_special p_special, const pathfinding_settings &settings ) const
+{
+    const int bash = settings.bash_strength;
+    const int climb_cost = settings.climb_cost;
+    const bool doors = settings.allow_open_doors;
+    const bool trapavoid = settings.avoid_traps;
+
+    route_step step;
+    if( !( p_special & non_normal ) ) {
+        // Boring flat dirt - the most common case above the ground
+        step.cost = 2;
+        return step;
+    }
+    if( settings.avoid_rough_terrain ) {
+        step.close = true; // Close all rough terrain tiles
+        return step;
+    }
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    const int cost = move_cost_internal( furniture, terrain, veh, part );
+    // Don't calculate bash rating unless we intend to actually use it
+    const int rating = ( bash == 0 || cost != 0 ) ? -1 :
+                       bash_rating_internal( bash, furniture, terrain, false, veh, part );
+
+    if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+        climb_cost <= 0 ) {
+        step.close = true; // Close it so that next time we won't try to calculate costs
+        return step;
+    }
+
+    int newg = cost;
+    if( cost == 0 ) {
+        if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            // Climbing fences
+            newg += climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                     !is_outside( cur ) ) ) {
+            // Only try to open INSIDE doors from the inside
+            // To open and then move onto the tile
+            newg += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            int dummy = -1;
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
+                  veh_at_internal( cur, dummy ) == veh ) ) {
+                // Handle car doors, but don't try to path through curtains
+                newg += 10; // One turn to open, 4 to move there
+            } else if( part >= 0 && bash > 0 ) {
+                // Car obstacle that isn't a door
+                // TODO: Account for armor
+                int hp = veh->parts[part].hp();
+                if( hp / 20 > bash ) {
+                    // Threshold damage thing means we just can't bash this down
+                    step.close = true;
+                    return step;
+                } else if( hp / 10 > bash ) {
+                    // Threshold damage thing means we will fail to deal damage pretty often
+                    hp *= 2;
+                }
+
+                newg += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
+                    // Won't be openable, don't try from other sides
+                    step.close = true;
+                }
+
+                return step;
+            }
+        } else if( rating > 1 ) {
+            // Expected number of turns to bash it down, 1 turn to move there
+            // and 5 turns of penalty not to trash everything just because we can
+            newg += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            // Desperate measures, avoid whenever possible
+            newg += 500;
+        } else {
+            // Unbashable and unopenable from here
+            if( !doors || !terrain.open || !furniture.open ) {
+                // Or anywhere else for that matter
+                step.close = true;
+            }
+
+            return step;
+        }
+    }
+
+    if( trapavoid && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            // For now make them detect all traps
+            if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                // Special case - ledge in z-levels
+                // Warning: really expensive, needs a cache
+                if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                    // Close p, because we won't be walking on it
+                    step.close = true;
+                    step.drop = true;
+                    return step;
+                }
+            } else {
+                // Otherwise it's walkable
+                newg += 500;
+            }
+        }
+    }
+
+    if( settings.avoid_sharp && p_special & PF_SHARP ) {
+        step.close = true; // Avoid sharp things
+        return step;
+    }
+
+    step.cost = newg;
+    return step;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -211,7 +659,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
     if( f.z == t.z ) {
         const auto line_path = line_to( f, t );
         const auto &pf_cache = get_pathfinding_cache_ref( f.z );
@@ -232,13 +679,9 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
-    int max_length = settings.max_length;
-    int bash = settings.bash_strength;
-    int climb_cost = settings.climb_cost;
-    bool doors = settings.allow_open_doors;
-    bool trapavoid = settings.avoid_traps;
-    bool roughavoid = settings.avoid_rough_terrain;
-    bool sharpavoid = settings.avoid_sharp;
+    if( const std::vector<tripoint> *cached = cached_routes->find( f, t, settings, pre_closed ) ) {
+        return *cached;
+    }
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
     int minx = std::min( f.x, t.x ) - pad;
@@ -252,7 +695,364 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( point( minx, miny ), point( maxx, maxy ) );
+    const tripoint min( minx, miny, minz );
+    const tripoint max( maxx, maxy, maxz );
+
+    // Nothing to avoid means the route can come from a flow field shared with other routes
+    if( pre_closed.empty() && f.z == t.z ) {
+        ret = route_flow( f, t, settings, min, max );
+        if( !ret.empty() ) {
+            return ret;
+        }
+    }
+
+    // Long routes are planned over submaps first
+    if( f.z == t.z && rl_dist( f, t ) > 2 * SEEX ) {
+        tripoint min;
+        tripoint max;
+        ret = route_portals( f, t, settings, pre_closed, min, max );
+        if( !ret.empty() ) {
+            cached_routes->store( f, t, settings, pre_closed, min + tripoint_below, max, ret );
+            return ret;
+        }
+    }
+
+    ret = route_search( f, t, settings, pre_closed, min, max );
+    // Ledges are checked one level below the search
+    cached_routes->store( f, t, settings, pre_closed, min + tripoint_below, max, ret );
+    return ret;
+}
+
+std::vector<tripoint> map::route_flow( const tripoint &f, const tripoint &t,
+                                       const pathfinding_settings &settings,
+                                       const tripoint &min, const tripoint &max ) const
+{
+    std::vector<tripoint> ret;
+    const route_cache::flow_field *field = cached_routes->find_flow_field( t, settings );
+    if( field == nullptr ) {
+        if( !cached_routes->wants_flow_field( t, settings ) ) {
+            return ret;
+        }
+        route_cache::flow_field &new_field = cached_routes->add_flow_field( t, settings );
+        field = &new_field;
+
+        // Dijkstra outward from the target over reversed steps: the cost of a tile is the
+        // cost of the cheapest route from it to the target.
+        const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+        path_open_set open;
+        std::vector<bool> expanded( MAPSIZE_X * MAPSIZE_Y, false );
+        new_field.cost[flat_index( t )] = 0;
+        open.push( 0, t );
+        while( !open.empty() ) {
+            const tripoint cur = open.pop();
+            const int cur_index = flat_index( cur );
+            if( expanded[cur_index] ) {
+                // Stale entry, the tile was reached more cheaply since it was pushed
+                continue;
+            }
+            expanded[cur_index] = true;
+            const int cur_cost = new_field.cost[cur_index];
+            if( cur_cost > settings.max_length ) {
+                // Everything left is too far to be routed to
+                break;
+            }
+            const pf_special cur_special = pf_cache.special[cur.x][cur.y];
+            for( const tripoint &p : points_in_radius( cur, 1 ) ) {
+                if( p == cur ) {
+                    continue;
+                }
+                const int index = flat_index( p );
+                // Step is from p onto cur, the reverse of the search direction
+                const route_step step = route_step_cost( p, cur, cur_special, settings );
+                if( step.cost < 0 || step.drop ) {
+                    continue;
+                }
+                // Penalize for diagonals or the path will look "unnatural"
+                const int cost = cur_cost + step.cost + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
+                if( new_field.cost[index] < 0 || cost < new_field.cost[index] ) {
+                    new_field.cost[index] = cost;
+                    new_field.next[index] = cur_index;
+                    open.push( cost, p );
+                }
+            }
+        }
+    }
+
+    int index = flat_index( f );
+    if( field->cost[index] < 0 || field->cost[index] > settings.max_length ) {
+        return ret;
+    }
+    const int target_index = flat_index( t );
+    while( index != target_index ) {
+        index = field->next[index];
+        const tripoint p( index / MAPSIZE_Y, index % MAPSIZE_Y, t.z );
+        if( p.x < min.x || p.x > max.x || p.y < min.y || p.y > max.y ) {
+            // route_search() never leaves the box, so it could not have found this route
+            ret.clear();
+            return ret;
+        }
+        ret.push_back( p );
+    }
+    return ret;
+}
+
+std::vector<int> map::route_submap_costs( const tripoint &from, const bool reverse,
+        const pathfinding_settings &settings ) const
+{
+    const point origin( from.x - from.x % SEEX, from.y - from.y % SEEY );
+    const auto local_index = [&origin]( const tripoint & p ) {
+        return ( p.x - origin.x ) * SEEY + p.y - origin.y;
+    };
+    std::vector<int> costs( SEEX * SEEY, -1 );
+    std::vector<bool> expanded( SEEX * SEEY, false );
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( from.z );
+
+    path_open_set open;
+    costs[local_index( from )] = 0;
+    open.push( 0, from );
+    while( !open.empty() ) {
+        const tripoint cur = open.pop();
+        const int cur_index = local_index( cur );
+        if( expanded[cur_index] ) {
+            continue;
+        }
+        expanded[cur_index] = true;
+        for( const point &offset : eight_adjacent_offsets ) {
+            const tripoint p = cur + offset;
+            if( p.x < origin.x || p.x >= origin.x + SEEX || p.y < origin.y || p.y >= origin.y + SEEY ) {
+                continue;
+            }
+            const route_step step = reverse ?
+                                    route_step_cost( p, cur, pf_cache.special[cur.x][cur.y], settings ) :
+                                    route_step_cost( cur, p, pf_cache.special[p.x][p.y], settings );
+            if( step.cost < 0 || step.drop ) {
+                continue;
+            }
+            const int index = local_index( p );
+            const int cost = costs[cur_index] + step.cost + ( ( offset.x != 0 && offset.y != 0 ) ? 1 : 0 );
+            if( costs[index] < 0 || cost < costs[index] ) {
+                costs[index] = cost;
+                open.push( cost, p );
+            }
+        }
+    }
+    return costs;
+}
+
+void map::build_portal_cluster( portal_cluster &cluster, const tripoint &grid,
+                                const pathfinding_settings &settings ) const
+{
+    cluster.portals.clear();
+    cluster.dirty = false;
+    const tripoint origin( grid.x * SEEX, grid.y * SEEY, grid.z );
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( grid.z );
+    const auto step_cost = [&]( const tripoint & from, const tripoint & to ) {
+        return route_step_cost( from, to, pf_cache.special[to.x][to.y], settings ).cost;
+    };
+
+    struct cluster_edge {
+        // First tile of the edge inside the cluster
+        point start;
+        // Direction along the edge
+        point along;
+        // Direction toward the neighbouring cluster
+        point out;
+    };
+    const std::array<cluster_edge, 4> edges{{
+            { point_zero, point_south, point_west },
+            { point( SEEX - 1, 0 ), point_south, point_east },
+            { point_zero, point_east, point_north },
+            { point( 0, SEEY - 1 ), point_east, point_south },
+        }
+    };
+    for( const cluster_edge &edge : edges ) {
+        const point neighbour = grid.xy() + edge.out;
+        if( neighbour.x < 0 || neighbour.x >= my_MAPSIZE || neighbour.y < 0 ||
+            neighbour.y >= my_MAPSIZE ) {
+            continue;
+        }
+        // One portal in the middle of every stretch passable in both directions
+        int stretch_start = -1;
+        for( int i = 0; i <= SEEX; i++ ) {
+            const tripoint inside = origin + edge.start + edge.along * i;
+            const tripoint outside = inside + edge.out;
+            const bool open = i < SEEX && step_cost( inside, outside ) >= 0 &&
+                              step_cost( outside, inside ) >= 0;
+            if( open && stretch_start < 0 ) {
+                stretch_start = i;
+            } else if( !open && stretch_start >= 0 ) {
+                const tripoint pos = origin + edge.start + edge.along * ( ( stretch_start + i - 1 ) / 2 );
+                submap_portal portal;
+                portal.pos = pos.xy();
+                portal.partner = pos.xy() + edge.out;
+                portal.partner_cost = step_cost( pos, pos + edge.out );
+                cluster.portals.push_back( portal );
+                stretch_start = -1;
+            }
+        }
+    }
+
+    for( submap_portal &portal : cluster.portals ) {
+        const std::vector<int> costs = route_submap_costs( tripoint( portal.pos, grid.z ), false,
+                                       settings );
+        for( size_t i = 0; i < cluster.portals.size(); i++ ) {
+            const point local = cluster.portals[i].pos - origin.xy();
+            const int cost = costs[local.x * SEEY + local.y];
+            if( &cluster.portals[i] != &portal && cost >= 0 ) {
+                portal.paths.emplace_back( static_cast<int>( i ), cost );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::route_portals( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+        tripoint &min, tripoint &max ) const
+{
+    submap_portals &graph = *route_portal_graph;
+    portal_layer &layer = graph.get_layer( f.z, settings );
+    const auto get_cluster = [&]( const int index ) -> const portal_cluster & {
+        portal_cluster &cluster = layer.clusters[index];
+        if( cluster.dirty )
+        {
+            build_portal_cluster( cluster, tripoint( index / my_MAPSIZE, index % my_MAPSIZE, f.z ),
+                                  settings );
+        }
+        return cluster;
+    };
+    const auto local_index = []( const point & p ) {
+        return ( p.x % SEEX ) * SEEY + p.y % SEEY;
+    };
+
+    const int start_cluster = graph.cluster_index( f.xy() );
+    const int goal_cluster = graph.cluster_index( t.xy() );
+    const std::vector<int> start_costs = route_submap_costs( f, false, settings );
+    const std::vector<int> goal_costs = route_submap_costs( t, true, settings );
+
+    // Abstract nodes are portals, keyed by cluster and index in it
+    constexpr int portal_bits = 6;
+    constexpr int start_key = -2;
+    constexpr int goal_key = -1;
+    const auto node_pos = [&]( const int key ) {
+        if( key == goal_key ) {
+            return t.xy();
+        }
+        return layer.clusters[key >> portal_bits].portals[key & ( ( 1 << portal_bits ) - 1 )].pos;
+    };
+    // Key to (cost so far, parent key)
+    std::unordered_map<int, std::pair<int, int>> best;
+    std::unordered_set<int> closed;
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+        std::greater<std::pair<int, int>>> open;
+    const auto relax = [&]( const int key, const int cost, const int parent ) {
+        const auto iter = best.find( key );
+        if( iter == best.end() || cost < iter->second.first ) {
+            best[key] = std::make_pair( cost, parent );
+            open.emplace( cost + 2 * rl_dist( node_pos( key ), t.xy() ), key );
+        }
+    };
+
+    const portal_cluster &first = get_cluster( start_cluster );
+    for( size_t i = 0; i < first.portals.size(); i++ ) {
+        const int cost = start_costs[local_index( first.portals[i].pos )];
+        if( cost >= 0 ) {
+            relax( ( start_cluster << portal_bits ) | static_cast<int>( i ), cost, start_key );
+        }
+    }
+
+    bool done = false;
+    while( !open.empty() ) {
+        const int key = open.top().second;
+        open.pop();
+        if( key == goal_key ) {
+            done = true;
+            break;
+        }
+        if( !closed.insert( key ).second ) {
+            continue;
+        }
+        const int cost = best[key].first;
+        if( cost > settings.max_length ) {
+            break;
+        }
+        const int cluster_index = key >> portal_bits;
+        const submap_portal &portal = get_cluster( cluster_index ).portals[key & ( ( 1 << portal_bits ) - 1 )];
+        if( cluster_index == goal_cluster ) {
+            const int goal_cost = goal_costs[local_index( portal.pos )];
+            if( goal_cost >= 0 ) {
+                relax( goal_key, cost + goal_cost, key );
+            }
+        }
+        for( const std::pair<int, int> &path : portal.paths ) {
+            relax( ( cluster_index << portal_bits ) | path.first, cost + path.second, key );
+        }
+        const int neighbour_index = graph.cluster_index( portal.partner );
+        const portal_cluster &neighbour = get_cluster( neighbour_index );
+        for( size_t i = 0; i < neighbour.portals.size(); i++ ) {
+            if( neighbour.portals[i].pos == portal.partner && neighbour.portals[i].partner == portal.pos ) {
+                relax( ( neighbour_index << portal_bits ) | static_cast<int>( i ),
+                       cost + portal.partner_cost, key );
+                break;
+            }
+        }
+    }
+    if( !done ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<tripoint> waypoints;
+    for( int key = goal_key; key != start_key; key = best[key].second ) {
+        waypoints.emplace_back( node_pos( key ), f.z );
+    }
+    std::reverse( waypoints.begin(), waypoints.end() );
+
+    // Refine the plan, each leg stays inside a single submap or crosses an edge
+    std::vector<tripoint> ret;
+    min = f;
+    max = f;
+    tripoint cur = f;
+    for( const tripoint &next : waypoints ) {
+        if( next == cur ) {
+            continue;
+        }
+        if( graph.cluster_index( next.xy() ) != graph.cluster_index( cur.xy() ) ) {
+            if( pre_closed.count( next ) ) {
+                return std::vector<tripoint>();
+            }
+            ret.push_back( next );
+            min = tripoint( std::min( min.x, next.x ), std::min( min.y, next.y ), min.z );
+            max = tripoint( std::max( max.x, next.x ), std::max( max.y, next.y ), max.z );
+        } else {
+            const tripoint box_min( cur.x - cur.x % SEEX, cur.y - cur.y % SEEY, cur.z );
+            const tripoint box_max = box_min + point( SEEX, SEEY );
+            const std::vector<tripoint> leg = route_search( cur, next, settings, pre_closed, box_min,
+                                              box_max );
+            if( leg.empty() ) {
+                return std::vector<tripoint>();
+            }
+            ret.insert( ret.end(), leg.begin(), leg.end() );
+            min = tripoint( std::min( min.x, box_min.x ), std::min( min.y, box_min.y ), min.z );
+            max = tripoint( std::max( max.x, box_max.x ), std::max( max.y, box_max.y ), max.z );
+        }
+        cur = next;
+    }
+    return ret;
+}
+
+std::vector<tripoint> map::route_search( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const std::set<tripoint> &pre_closed,
+        const tripoint &min, const tripoint &max ) const
+{
+    std::vector<tripoint> ret;
+    const int max_length = settings.max_length;
+    const int minx = min.x;
+    const int miny = min.y;
+    const int minz = min.z;
+    const int maxx = max.x;
+    const int maxy = max.y;
+    const int maxz = max.z;
+
+    pathfinder &pf = get_pathfinder();
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -273,8 +1073,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
@@ -288,7 +1087,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
@@ -307,140 +1106,35 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.get_state( index ) == ASL_CLOSED ) {
                 continue;
             }
 
-            // Penalize for diagonals or the path will look "unnatural"
-            int newg = layer.gscore[parent_index] + ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
-
-            const auto p_special = pf_cache.special[p.x][p.y];
-            // TODO: De-uglify, de-huge-n
-            if( !( p_special & non_normal ) ) {
-                // Boring flat dirt - the most common case above the ground
-                newg += 2;
-            } else {
-                if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
-                    continue;
+            const route_step step = route_step_cost( cur, p, pf_cache.special[p.x][p.y], settings );
+            if( step.drop ) {
+                tripoint below( p.xy(), p.z - 1 );
+                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
+                    // Otherwise this would have been a huge fall
+                    // From cur, not p, because we won't be walking on air
+                    pf.add_point( layer.gscore[parent_index] + 10,
+                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
+                                  cur, below );
                 }
-
-                int part = -1;
-                const maptile &tile = maptile_at_internal( p );
-                const auto &terrain = tile.get_ter_t();
-                const auto &furniture = tile.get_furn_t();
-                const vehicle *veh = veh_at_internal( p, part );
-
-                const int cost = move_cost_internal( furniture, terrain, veh, part );
-                // Don't calculate bash rating unless we intend to actually use it
-                const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
-
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
-                    climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
-                    continue;
-                }
-
-                newg += cost;
-                if( cost == 0 ) {
-                    if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
-                        // Climbing fences
-                        newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                 !is_outside( cur ) ) ) {
-                        // Only try to open INSIDE doors from the inside
-                        // To open and then move onto the tile
-                        newg += 4;
-                    } else if( veh != nullptr ) {
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
-                        part = vpobst ? vpobst->part_index() : -1;
-                        int dummy = -1;
-                        if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
-                            ( !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ||
-                              veh_at_internal( cur, dummy ) == veh ) ) {
-                            // Handle car doors, but don't try to path through curtains
-                            newg += 10; // One turn to open, 4 to move there
-                        } else if( part >= 0 && bash > 0 ) {
-                            // Car obstacle that isn't a door
-                            // TODO: Account for armor
-                            int hp = veh->parts[part].hp();
-                            if( hp / 20 > bash ) {
-                                // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            } else if( hp / 10 > bash ) {
-                                // Threshold damage thing means we will fail to deal damage pretty often
-                                hp *= 2;
-                            }
-
-                            newg += 2 * hp / bash + 8 + 4;
-                        } else if( part >= 0 ) {
-                            if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
-                                // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
-                            }
-
-                            continue;
-                        }
-                    } else if( rating > 1 ) {
-                        // Expected number of turns to bash it down, 1 turn to move there
-                        // and 5 turns of penalty not to trash everything just because we can
-                        newg += ( 20 / rating ) + 2 + 10;
-                    } else if( rating == 1 ) {
-                        // Desperate measures, avoid whenever possible
-                        newg += 500;
-                    } else {
-                        // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
-                            // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
-                        }
-
-                        continue;
-                    }
-                }
-
-                if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
-                    const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
-                    if( !trp.is_benign() ) {
-                        // For now make them detect all traps
-                        if( has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                            // Special case - ledge in z-levels
-                            // Warning: really expensive, needs a cache
-                            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
-                                tripoint below( p.xy(), p.z - 1 );
-                                if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
-                                    // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
-                                    // From cur, not p, because we won't be walking on air
-                                    pf.add_point( layer.gscore[parent_index] + 10,
-                                                  layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
-                                                  cur, below );
-                                }
-
-                                // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
-                                continue;
-                            }
-                        } else if( trapavoid ) {
-                            // Otherwise it's walkable
-                            newg += 500;
-                        }
-                    }
-                }
-
-                if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
-                }
-
             }
+            if( step.close ) {
+                layer.set_state( index, ASL_CLOSED );
+            }
+            if( step.cost < 0 ) {
+                continue;
+            }
+
+            // Penalize for diagonals or the path will look "unnatural"
+            const int newg = layer.gscore[parent_index] + step.cost +
+                             ( ( cur.x != p.x && cur.y != p.y ) ? 1 : 0 );
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.get_state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -455,7 +1149,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         if( settings.allow_climb_stairs && cur.z > minz && parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -464,7 +1157,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         if( settings.allow_climb_stairs && cur.z < maxz && parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -472,7 +1164,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         }
         if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
             valid_move( cur, tripoint( cur.xy(), cur.z + 1 ), false, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
                 pf.add_point( layer.gscore[parent_index] + 4,
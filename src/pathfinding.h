@@ -2,7 +2,15 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <cstddef>
+#include <list>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -70,6 +78,152 @@ struct pathfinding_settings {
         : bash_strength( bs ), max_dist( md ), max_length( ml ), climb_cost( cc ),
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
+
+    bool operator==( const pathfinding_settings &rhs ) const;
+    bool operator!=( const pathfinding_settings &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
+// Result of evaluating a single step of a route onto an adjacent tile
+struct route_step {
+    // Cost of the step on top of the diagonal penalty, negative if it can't be taken
+    int cost = -1;
+    // The tile can't be entered from any direction, the search may close it
+    bool close = false;
+    // The tile is a ledge, a route over it drops to the level below instead
+    bool drop = false;
+};
+
+/**
+ * Results of recent map::route searches.
+ *
+ * Routes are remembered together with the area their search could look at, and are
+ * dropped as soon as a submap overlapping that area has its pathfinding cache marked dirty.
+ *
+ * Targets that many routes head to within a turn (a horde chasing the player) get a flow
+ * field: a single Dijkstra search outward from the target, which every later route toward
+ * it descends instead of running its own search.
+ */
+class route_cache
+{
+    public:
+        // Distances to a single target on its z-level, for one set of pathfinding settings
+        struct flow_field {
+            tripoint target;
+            pathfinding_settings settings;
+            time_point created;
+            // Cost of the cheapest route to target, negative if there is none, by flat index
+            std::vector<int> cost;
+            // Flat index of the next step toward target
+            std::vector<int> next;
+        };
+
+        /** Returns the cached route for the arguments of map::route, or nullptr. */
+        const std::vector<tripoint> *find( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings,
+                                           const std::set<tripoint> &pre_closed );
+        /** Remembers a route whose search was limited to the box [min, max]. */
+        void store( const tripoint &f, const tripoint &t, const pathfinding_settings &settings,
+                    const std::set<tripoint> &pre_closed, const tripoint &min, const tripoint &max,
+                    const std::vector<tripoint> &path );
+
+        /**
+         * Counts a route request toward @p t and returns whether enough of them arrived this
+         * turn that a flow field should be built.
+         */
+        bool wants_flow_field( const tripoint &t, const pathfinding_settings &settings );
+        /** Returns a flow field built this turn for the given target and settings, or nullptr. */
+        const flow_field *find_flow_field( const tripoint &t, const pathfinding_settings &settings );
+        /** Adds an empty flow field for the target and returns it so it can be filled. */
+        flow_field &add_flow_field( const tripoint &t, const pathfinding_settings &settings );
+
+        /** Drops everything that depends on the given z-level. */
+        void invalidate( int zlev );
+        /** Drops everything that depends on the box [min, max] (in local coords). */
+        void invalidate( const tripoint &min, const tripoint &max );
+        void clear();
+
+    private:
+        struct cached_route {
+            tripoint from;
+            tripoint to;
+            pathfinding_settings settings;
+            std::set<tripoint> pre_closed;
+            // Bounding box of the search, inclusive
+            tripoint min;
+            tripoint max;
+            time_point created;
+            std::vector<tripoint> path;
+        };
+        struct route_demand {
+            tripoint target;
+            pathfinding_settings settings;
+            int count;
+        };
+
+        // Most recently used first
+        std::list<cached_route> routes;
+        std::list<flow_field> flow_fields;
+        std::vector<route_demand> demands;
+        time_point demands_turn;
+};
+
+struct submap_portal {
+    // Local map coordinates of the portal tile
+    point pos;
+    // Tile on the other side of the edge, inside the neighbouring cluster
+    point partner;
+    // Cost of stepping onto partner
+    int partner_cost = 0;
+    // Cheapest routes inside the cluster to its other portals: index, cost
+    std::vector<std::pair<int, int>> paths;
+};
+
+struct portal_cluster {
+    bool dirty = true;
+    std::vector<submap_portal> portals;
+};
+
+// All clusters of one z-level, built for one set of settings
+struct portal_layer {
+    int zlev = 0;
+    pathfinding_settings settings;
+    std::vector<portal_cluster> clusters;
+};
+
+/**
+ * Abstract graph for planning routes across the reality bubble.
+ *
+ * Every submap is a cluster, connected to its neighbours by portals placed in the middle of
+ * each passable stretch of their shared edge. Inside a cluster, portals are linked by the
+ * cost of the cheapest route between them. Long routes are planned portal to portal and then
+ * refined with searches limited to single submaps.
+ *
+ * Clusters are rebuilt lazily, only after their submap (or a neighbouring one, which moves
+ * the shared portals) had its pathfinding cache marked dirty.
+ */
+class submap_portals
+{
+    public:
+        explicit submap_portals( int mapsize );
+
+        int cluster_index( const point &p ) const;
+        /** Returns the layer for the given level and settings, creating it if needed. */
+        portal_layer &get_layer( int zlev, const pathfinding_settings &settings );
+
+        /** Marks all clusters of the level for rebuilding. */
+        void invalidate( int zlev );
+        /** Marks the clusters overlapping the box [min, max] and their neighbours for rebuilding. */
+        void invalidate( const tripoint &min, const tripoint &max );
+        /** Moves the clusters along with a map shift of @p sp submaps. */
+        void shift( const point &sp );
+        void clear();
+
+    private:
+        int mapsize;
+        // Most recently used first
+        std::list<portal_layer> layers;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
@@ -0,0 +1,119 @@
+#include "recipe_availability.h"
+
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+#include "avatar.h"
+#include "hash_utils.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_contents.h"
+#include "itype.h"
+#include "recipe.h"
+#include "recipe_dictionary.h"
+#include "requirements.h"
+#include "type_id.h"
+
+static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
+
+// Everything about an item that requirement checks look at besides its type
+static size_t item_fingerprint( const item &it )
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, it.charges );
+    cata::hash_combine( seed, it.ammo_remaining() );
+    cata::hash_combine( seed, it.rotten() );
+    cata::hash_combine( seed, it.allow_crafting_component() );
+    cata::hash_combine( seed, it.is_filthy() );
+    cata::hash_combine( seed, it.contents.empty() );
+    return seed;
+}
+
+recipe_availability::result recipe_availability::evaluate( const recipe &r, const inventory &inv,
+        int batch_size )
+{
+    result res;
+    const std::function<bool( const item & )> all_items_filter = r.get_component_filter(
+                recipe_filter_flags::none );
+    res.could_craft = r.deduped_requirements().can_make_with_inventory(
+                          inv, all_items_filter, batch_size, cost_adjustment::start_only );
+    // Without rotten items there can only be less
+    if( res.could_craft ) {
+        res.could_craft_non_rotten = r.deduped_requirements().can_make_with_inventory(
+                                         inv, r.get_component_filter( recipe_filter_flags::no_rotten ), batch_size,
+                                         cost_adjustment::start_only );
+    }
+    res.apparently_craftable = r.simple_requirements().can_make_with_inventory(
+                                   inv, all_items_filter, batch_size, cost_adjustment::start_only );
+    return res;
+}
+
+void recipe_availability::update( const inventory &new_inv )
+{
+    inv = &new_inv;
+
+    std::unordered_map<itype_id, size_t> new_fingerprints;
+    for( const std::pair<const itype_id, std::list<const item *>> &bin : new_inv.get_binned_items() ) {
+        // Summed, so that the order of the items doesn't matter
+        size_t sum = bin.second.size();
+        for( const item *it : bin.second ) {
+            sum += item_fingerprint( *it );
+        }
+        new_fingerprints.emplace( bin.first, sum );
+    }
+    const int new_ups_charges = new_inv.charges_of( "UPS" );
+    const bool new_hammerspace = get_avatar().has_trait( trait_DEBUG_HS );
+
+    if( recipes_version != recipe_dict.version() || ups_charges != new_ups_charges ||
+        hammerspace != new_hammerspace ) {
+        results.clear();
+    } else if( !results.empty() ) {
+        for( const std::pair<const itype_id, size_t> &fp : new_fingerprints ) {
+            const auto old = fingerprints.find( fp.first );
+            if( old == fingerprints.end() || old->second != fp.second ) {
+                forget_requiring( fp.first );
+            }
+        }
+        for( const std::pair<const itype_id, size_t> &fp : fingerprints ) {
+            if( new_fingerprints.count( fp.first ) == 0 ) {
+                forget_requiring( fp.first );
+            }
+        }
+    }
+
+    fingerprints = std::move( new_fingerprints );
+    ups_charges = new_ups_charges;
+    hammerspace = new_hammerspace;
+    recipes_version = recipe_dict.version();
+}
+
+void recipe_availability::forget_requiring( const itype_id &type )
+{
+    for( const recipe *r : recipe_dict.requiring( type ) ) {
+        results.erase( r );
+    }
+    const itype *t = item::find_type( type );
+    for( const std::pair<const quality_id, int> &qual : t->qualities ) {
+        for( const recipe *r : recipe_dict.requiring( qual.first ) ) {
+            results.erase( r );
+        }
+    }
+}
+
+const recipe_availability::result &recipe_availability::get( const recipe &r )
+{
+    const auto iter = results.find( &r );
+    if( iter != results.end() ) {
+        return iter->second;
+    }
+    return results.emplace( &r, evaluate( r, *inv, 1 ) ).first->second;
+}
+
+void recipe_availability::clear()
+{
+    inv = nullptr;
+    fingerprints.clear();
+    results.clear();
+}
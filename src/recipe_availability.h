@@ -0,0 +1,59 @@
+#pragma once
+#ifndef CATA_SRC_RECIPE_AVAILABILITY_H
+#define CATA_SRC_RECIPE_AVAILABILITY_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+class inventory;
+class recipe;
+
+using itype_id = std::string;
+
+/**
+ * Remembers which recipes can be made with a crafting inventory, as the crafting menu shows them.
+ *
+ * Results are kept when the inventory changes. @ref update compares the new inventory with the
+ * previous one type by type and only forgets the results of recipes that need one of the changed
+ * item types, or a quality such an item has.
+ */
+class recipe_availability
+{
+    public:
+        struct result {
+            /** Enough of everything, rotten components included. */
+            bool could_craft = false;
+            /** Enough of everything without rotten components. */
+            bool could_craft_non_rotten = false;
+            /** Enough of everything when each requirement is checked on its own. */
+            bool apparently_craftable = false;
+        };
+
+        /** Checks a batch of @p r against @p inv. */
+        static result evaluate( const recipe &r, const inventory &inv, int batch_size );
+
+        /** Switches to @p inv, which has to outlive the following calls to @ref get. */
+        void update( const inventory &inv );
+        /** Availability of a single batch of @p r with the inventory of the last update. */
+        const result &get( const recipe &r );
+        /** Number of recipes with a remembered result. */
+        size_t size() const {
+            return results.size();
+        }
+        void clear();
+
+    private:
+        // Forgets the results of recipes that depend on items of the type
+        void forget_requiring( const itype_id &type );
+
+        const inventory *inv = nullptr;
+        /** Summary of the items of each type, any change of it is treated as a change of the type. */
+        std::unordered_map<itype_id, size_t> fingerprints;
+        int ups_charges = 0;
+        bool hammerspace = false;
+        int recipes_version = -1;
+        std::unordered_map<const recipe *, result> results;
+};
+
+#endif // CATA_SRC_RECIPE_AVAILABILITY_H
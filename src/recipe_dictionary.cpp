@@ -331,6 +331,18 @@ std::map<recipe_id, recipe>::const_iterator recipe_dictionary::end() const
     return recipes.end();
 }
 
+const std::set<const recipe *> &recipe_dictionary::requiring( const itype_id &id ) const
+{
+    const auto iter = by_item.find( id );
+    return iter != by_item.end() ? iter->second : null_match;
+}
+
+const std::set<const recipe *> &recipe_dictionary::requiring( const quality_id &id ) const
+{
+    const auto iter = by_quality.find( id );
+    return iter != by_quality.end() ? iter->second : null_match;
+}
+
 bool recipe_dictionary::is_item_on_loop( const itype_id &i ) const
 {
     return items_on_loops.count( i );
@@ -464,6 +476,28 @@ void recipe_dictionary::finalize()
         }
     }
 
+    // Index the recipes by what they need
+    for( const auto &e : recipe_dict.recipes ) {
+        const recipe *r = &e.second;
+        const requirement_data &req = r->simple_requirements();
+        for( const std::vector<item_comp> &opts : req.get_components() ) {
+            for( const item_comp &comp : opts ) {
+                recipe_dict.by_item[comp.type].insert( r );
+            }
+        }
+        for( const std::vector<tool_comp> &opts : req.get_tools() ) {
+            for( const tool_comp &tool : opts ) {
+                recipe_dict.by_item[tool.type].insert( r );
+            }
+        }
+        for( const std::vector<quality_requirement> &opts : req.get_qualities() ) {
+            for( const quality_requirement &qual : opts ) {
+                recipe_dict.by_quality[qual.type].insert( r );
+            }
+        }
+    }
+    recipe_dict.loaded_version++;
+
     recipe_dict.find_items_on_loops();
 }
 
@@ -475,6 +509,9 @@ void recipe_dictionary::reset()
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
     recipe_dict.items_on_loops.clear();
+    recipe_dict.by_item.clear();
+    recipe_dict.by_quality.clear();
+    recipe_dict.loaded_version++;
 }
 
 void recipe_dictionary::delete_if( const std::function<bool( const recipe & )> &pred )
@@ -8,6 +8,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -42,6 +43,16 @@ class recipe_dictionary
 
         bool is_item_on_loop( const itype_id & ) const;
 
+        /** Returns all recipes that need the item type as a component or tool */
+        const std::set<const recipe *> &requiring( const itype_id &id ) const;
+        /** Returns all recipes that need a tool with the quality */
+        const std::set<const recipe *> &requiring( const quality_id &id ) const;
+
+        /** Changes whenever recipes are loaded, caches holding recipe pointers compare it */
+        int version() const {
+            return loaded_version;
+        }
+
         /** Returns disassembly recipe (or null recipe if no match) */
         static const recipe &get_uncraft( const itype_id &id );
 
@@ -67,6 +78,9 @@ class recipe_dictionary
         std::set<const recipe *> autolearn;
         std::set<const recipe *> blueprints;
         std::unordered_set<itype_id> items_on_loops;
+        std::unordered_map<itype_id, std::set<const recipe *>> by_item;
+        std::unordered_map<quality_id, std::set<const recipe *>> by_quality;
+        int loaded_version = 0;
 
         static void finalize_internal( std::map<recipe_id, recipe> &obj );
         void find_items_on_loops();
@@ -11,13 +11,13 @@
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
     return rng_uint_dist( rng_get_engine() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -26,22 +26,25 @@ int rng( int lo, int hi )
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
     return rng_real_dist( rng_get_engine(), std::uniform_real_distribution<>::param_type( lo, hi ) );
 }
 
+// Keeps the second value of each pair it draws, reset whenever the engine changes so the
+// values only depend on the engine they are drawn from
+static thread_local std::normal_distribution<double> rng_normal_dist;
+
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
     return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
     return rng_exponential_dist( rng_get_engine(),
                                  std::exponential_distribution<>::param_type( lambda ) );
 }
@@ -122,8 +125,13 @@ double rng_normal( double lo, double hi )
     return clamp( val, lo, hi );
 }
 
+static thread_local cata_default_random_engine *engine_override = nullptr;
+
 cata_default_random_engine &rng_get_engine()
 {
+    if( engine_override != nullptr ) {
+        return *engine_override;
+    }
     // NOLINTNEXTLINE(cata-determinism)
     static cata_default_random_engine eng(
         std::chrono::high_resolution_clock::now().time_since_epoch().count() );
@@ -134,9 +142,23 @@ void rng_set_engine_seed( unsigned int seed )
 {
     if( seed != 0 ) {
         rng_get_engine().seed( seed );
+        rng_normal_dist.reset();
     }
 }
 
+rng_engine_override::rng_engine_override( cata_default_random_engine &engine ) :
+    previous( engine_override )
+{
+    engine_override = &engine;
+    rng_normal_dist.reset();
+}
+
+rng_engine_override::~rng_engine_override()
+{
+    engine_override = previous;
+    rng_normal_dist.reset();
+}
+
 namespace weighted_list_detail
 {
 unsigned int gen_rand_i()
@@ -22,6 +22,24 @@ using cata_default_random_engine = std::minstd_rand0;
 cata_default_random_engine &rng_get_engine();
 unsigned int rng_bits();
 
+/**
+ * While alive, random numbers drawn on the current thread come from @p engine instead
+ * of the shared one. Lets work done on other threads stay deterministic, each task gets
+ * its own engine seeded from the shared one beforehand.
+ */
+class rng_engine_override
+{
+    public:
+        explicit rng_engine_override( cata_default_random_engine &engine );
+        ~rng_engine_override();
+
+        rng_engine_override( const rng_engine_override & ) = delete;
+        rng_engine_override &operator=( const rng_engine_override & ) = delete;
+
+    private:
+        cata_default_random_engine *previous;
+};
+
 int rng( int lo, int hi );
 double rng_float( double lo, double hi );
 bool one_in( int chance );
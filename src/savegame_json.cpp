@@ -4012,6 +4012,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
             }
         }
+        rebuild_field_tiles();
     } else if( member_name == "graffiti" ) {
         jsin.start_array();
         while( !jsin.end_array() ) {
@@ -14,6 +14,7 @@
 #include "map.h"
 #include "output.h"
 #include "string_id.h"
+#include "turn_profiler.h"
 
 static constexpr int SCENT_RADIUS = 40;
 
@@ -54,6 +55,8 @@ void scent_map::reset()
             val = 0;
         }
     }
+    active_min = point_zero;
+    active_max = point_zero;
     typescent = scenttype_id();
 }
 
@@ -89,6 +92,9 @@ void scent_map::shift( const point &sm_shift )
         }
     }
     grscent = new_scent;
+    active_min = point( std::max( active_min.x - sm_shift.x, 0 ), std::max( active_min.y - sm_shift.y, 0 ) );
+    active_max = point( std::min( active_max.x - sm_shift.x, MAPSIZE_X ),
+                        std::min( active_max.y - sm_shift.y, MAPSIZE_Y ) );
 }
 
 int scent_map::get( const tripoint &p ) const
@@ -109,6 +115,15 @@ void scent_map::set( const tripoint &p, int value, const scenttype_id &type )
 void scent_map::set_unsafe( const tripoint &p, int value, const scenttype_id &type )
 {
     grscent[p.x][p.y] = value;
+    if( value != 0 ) {
+        if( active_min.x >= active_max.x || active_min.y >= active_max.y ) {
+            active_min = p.xy();
+            active_max = p.xy() + point_south_east;
+        } else {
+            active_min = point( std::min( active_min.x, p.x ), std::min( active_min.y, p.y ) );
+            active_max = point( std::max( active_max.x, p.x + 1 ), std::max( active_max.y, p.y + 1 ) );
+        }
+    }
     if( !type.is_empty() ) {
         typescent = type;
     }
@@ -150,6 +165,7 @@ bool scent_map::inbounds( const tripoint &p ) const
 
 void scent_map::update( const tripoint &center, map &m )
 {
+    CATA_PROFILE_ZONE( "scent_map::update" );
     // Stop updating scent after X turns of the player not moving.
     // Once wind is added, need to reset this on wind shifts as well.
     if( !player_last_position || center != *player_last_position ) {
@@ -159,90 +175,84 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
-
-    // these are for caching flag lookups
-    scent_array<bool> blocks_scent; // currently only TFLAG_NO_SCENT blocks scent
-    scent_array<bool> reduces_scent;
+    if( active_min.x >= active_max.x || active_min.y >= active_max.y ) {
+        // No scent anywhere, so nothing can diffuse
+        return;
+    }
 
-    // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    // Scent diffuses within SCENT_RADIUS of the player, but only where there is scent or next
+    // to it, everything else stays at zero. Inclusive bounds, kept one square away from the
+    // edges because diffusion reads the neighbours.
+    const int minx = std::max( { center.x - SCENT_RADIUS, active_min.x - 1, 1 } );
+    const int maxx = std::min( { center.x + SCENT_RADIUS, active_max.x, MAPSIZE_X - 2 } );
+    const int miny = std::max( { center.y - SCENT_RADIUS, active_min.y - 1, 1 } );
+    const int maxy = std::min( { center.y + SCENT_RADIUS, active_max.y, MAPSIZE_Y - 2 } );
+    if( minx > maxx || miny > maxy ) {
+        return;
+    }
 
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
     const int diffusivity = 100;
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
-    // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // MAPSIZE_X, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+    m.scent_blockers( blocks_scent, reduces_scent, point( minx - 1, miny - 1 ),
+                      point( maxx + 1, maxy + 1 ) );
+
+    // Sum neighbors in the y direction. This way, each square gets called 3 times instead of 9
+    // times. Columns are contiguous in memory and the loops don't branch, so the compiler can
+    // vectorize them.
+    std::array<int, MAPSIZE_Y> weight;
+    std::array<int, MAPSIZE_Y> weighted_scent;
+    for( int x = minx - 1; x <= maxx + 1; ++x ) {
+        for( int y = miny - 1; y <= maxy + 1; ++y ) {
+            // only 20% of scent can diffuse on REDUCE_SCENT squares
+            weight[y] = blocks_scent[x][y] ? 0 : reduces_scent[x][y] ? 2 : 10;
+            weighted_scent[y] = weight[y] * grscent[x][y];
+        }
+        for( int y = miny; y <= maxy; ++y ) {
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3_scent[x][y] = weighted_scent[y - 1] + weighted_scent[y] + weighted_scent[y + 1];
+            squares_used[x][y] = weight[y - 1] + weight[y] + weight[y + 1];
         }
     }
 
     // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
+    for( int x = minx; x <= maxx; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int used = squares_used[x - 1][y] + squares_used[x][y] + squares_used[x + 1][y];
+            // less air movement for REDUCE_SCENT square
+            const int this_diffusivity = reduces_scent[x][y] ? diffusivity / 5 : diffusivity;
+            // take the old scent and subtract what diffuses out, and what neighboring
+            // REDUCE_SCENT squares absorb
+            const int kept = grscent[x][y] * ( 10 * 1000 - used * this_diffusivity -
+                                               this_diffusivity / 5 * ( 90 - used ) );
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            const int diffused = ( kept + this_diffusivity * ( sum_3_scent[x - 1][y] +
+                                   sum_3_scent[x][y] + sum_3_scent[x + 1][y] ) ) / ( 1000 * 10 );
+            // cells that block scent via NO_SCENT (in json) have none
+            grscent[x][y] = blocks_scent[x][y] ? 0 : diffused;
+        }
+    }
 
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
+    if( active_min.x < minx || active_min.y < miny || active_max.x > maxx + 1 ||
+        active_max.y > maxy + 1 ) {
+        // Some scent wasn't updated, scent spread by at most one square
+        active_min = point( std::min( active_min.x, minx ), std::min( active_min.y, miny ) );
+        active_max = point( std::max( active_max.x, maxx + 1 ), std::max( active_max.y, maxy + 1 ) );
+        return;
+    }
+    // Everything was updated, shrink the bounds to where scent is left
+    active_min = point( maxx + 1, maxy + 1 );
+    active_max = point( minx, miny );
+    for( int x = minx; x <= maxx; ++x ) {
+        for( int y = miny; y <= maxy; ++y ) {
+            if( grscent[x][y] != 0 ) {
+                active_min = point( std::min( active_min.x, x ), std::min( active_min.y, y ) );
+                active_max = point( std::max( active_max.x, x + 1 ), std::max( active_max.y, y + 1 ) );
             }
         }
     }
@@ -46,12 +46,22 @@ class scent_map
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
         scent_array<int> grscent;
+        // All scent lies within this area, half-open
+        point active_min;
+        point active_max;
         scenttype_id typescent;
         cata::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
 
         const game &gm;
 
+    private:
+        // Scratch space for update, kept here to keep it off the stack
+        scent_array<int> sum_3_scent;
+        scent_array<int> squares_used;
+        scent_array<bool> blocks_scent;
+        scent_array<bool> reduces_scent;
+
     public:
         scent_map( const game &g ) : gm( g ) { }
 
@@ -40,6 +40,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
@@ -299,6 +300,7 @@ static int get_signal_for_hordes( const centroid &centr )
 
 void sounds::process_sounds()
 {
+    CATA_PROFILE_ZONE( "sounds::process_sounds" );
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = weather::sound_attn( g->weather.weather );
     for( const auto &this_centroid : sound_clusters ) {
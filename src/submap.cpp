@@ -227,6 +227,26 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+void submap::mark_field_tile( const point &p )
+{
+    const auto iter = std::lower_bound( field_tiles.begin(), field_tiles.end(), p );
+    if( iter == field_tiles.end() || *iter != p ) {
+        field_tiles.insert( iter, p );
+    }
+}
+
+void submap::rebuild_field_tiles()
+{
+    field_tiles.clear();
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            if( fld[x][y].field_count() > 0 ) {
+                field_tiles.emplace_back( x, y );
+            }
+        }
+    }
+}
+
 void submap::rotate( int turns )
 {
     turns = turns % 4;
@@ -272,6 +292,11 @@ void submap::rotate( int turns )
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
 
+    for( point &elem : field_tiles ) {
+        elem = rotate_point( elem );
+    }
+    std::sort( field_tiles.begin(), field_tiles.end() );
+
     for( auto &elem : cosmetics ) {
         elem.pos = rotate_point( elem.pos );
     }
@@ -175,6 +175,11 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /** Adds @p p to @ref field_tiles, to be called when the field there gains an entry. */
+        void mark_field_tile( const point &p );
+        /** Refills @ref field_tiles after fields were placed without @ref mark_field_tile. */
+        void rebuild_field_tiles();
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -237,7 +242,14 @@ class submap : maptile_soa<SEEX, SEEY>
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Tiles with fields, sorted in the order field processing visits them. Tiles that lost
+         * their fields are only dropped when field processing gets to them.
+         */
+        std::vector<point> field_tiles;
         time_point last_touched = calendar::turn_zero;
+        /** Fields on this submap have been processed up to this turn. */
+        time_point fields_updated = calendar::turn_zero;
         std::vector<spawn_point> spawns;
         /**
          * Vehicles on this submap (their (0,0) point is on this submap).
@@ -26,6 +26,7 @@
 #include "sounds.h"
 #include "text_snippets.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 
 static const mtype_id mon_amigara_horror( "mon_amigara_horror" );
@@ -302,6 +303,7 @@ void timed_event::per_turn()
 
 void timed_event_manager::process()
 {
+    CATA_PROFILE_ZONE( "timed_event_manager::process" );
     for( auto it = events.begin(); it != events.end(); ) {
         it->per_turn();
         if( it->when <= calendar::turn ) {
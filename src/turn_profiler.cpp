@@ -0,0 +1,242 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+#include "fstream_utils.h"
+#include "json.h"
+
+namespace turn_profiler
+{
+
+namespace
+{
+
+struct recorded_zone {
+    int zone;
+    clock::time_point start;
+    clock::duration duration;
+};
+
+struct turn_totals {
+    std::vector<clock::duration> durations;
+    std::vector<int> calls;
+};
+
+struct profiler_state {
+    // Guards zone_names, everything else is only touched by the recording thread
+    std::mutex names_mutex;
+    std::vector<std::string> zone_names;
+
+    std::atomic<bool> is_enabled{ false };
+    std::thread::id recording_thread;
+    clock::time_point epoch = clock::now();
+
+    // Ring buffer of the latest zones
+    std::vector<recorded_zone> zones;
+    size_t next_zone = 0;
+
+    turn_totals current_turn;
+    std::deque<turn_totals> past_turns;
+};
+
+profiler_state &state()
+{
+    static profiler_state instance;
+    return instance;
+}
+
+double to_milliseconds( clock::duration d )
+{
+    return std::chrono::duration<double, std::milli>( d ).count();
+}
+
+double to_microseconds( clock::duration d )
+{
+    return std::chrono::duration<double, std::micro>( d ).count();
+}
+
+} // namespace
+
+int register_zone( const char *name )
+{
+    profiler_state &s = state();
+    std::lock_guard<std::mutex> lock( s.names_mutex );
+    const auto iter = std::find( s.zone_names.begin(), s.zone_names.end(), name );
+    if( iter != s.zone_names.end() ) {
+        return static_cast<int>( iter - s.zone_names.begin() );
+    }
+    s.zone_names.emplace_back( name );
+    return static_cast<int>( s.zone_names.size() - 1 );
+}
+
+void set_enabled( bool enable )
+{
+    profiler_state &s = state();
+    if( enable == s.is_enabled ) {
+        return;
+    }
+    if( enable ) {
+        s.recording_thread = std::this_thread::get_id();
+        s.current_turn = turn_totals();
+    }
+    s.is_enabled = enable;
+}
+
+bool enabled()
+{
+    return state().is_enabled.load( std::memory_order_relaxed );
+}
+
+void clear()
+{
+    profiler_state &s = state();
+    s.zones.clear();
+    s.next_zone = 0;
+    s.current_turn = turn_totals();
+    s.past_turns.clear();
+    s.epoch = clock::now();
+}
+
+void next_turn()
+{
+    profiler_state &s = state();
+    if( !s.is_enabled ) {
+        return;
+    }
+    s.past_turns.emplace_back( std::move( s.current_turn ) );
+    s.current_turn = turn_totals();
+    while( s.past_turns.size() > static_cast<size_t>( averaged_turns ) ) {
+        s.past_turns.pop_front();
+    }
+}
+
+std::vector<zone_average> averages()
+{
+    profiler_state &s = state();
+    std::vector<zone_average> result;
+    if( s.past_turns.empty() ) {
+        return result;
+    }
+    {
+        std::lock_guard<std::mutex> lock( s.names_mutex );
+        for( const std::string &name : s.zone_names ) {
+            zone_average avg;
+            avg.name = name;
+            result.push_back( avg );
+        }
+    }
+    std::vector<clock::duration> totals( result.size(), clock::duration::zero() );
+    for( const turn_totals &turn : s.past_turns ) {
+        for( size_t i = 0; i < turn.durations.size(); ++i ) {
+            totals[i] += turn.durations[i];
+            result[i].max_milliseconds = std::max( result[i].max_milliseconds,
+                                                   to_milliseconds( turn.durations[i] ) );
+            result[i].calls += turn.calls[i];
+        }
+    }
+    const double turns = s.past_turns.size();
+    for( size_t i = 0; i < result.size(); ++i ) {
+        result[i].milliseconds = to_milliseconds( totals[i] ) / turns;
+        result[i].calls /= turns;
+    }
+    result.erase( std::remove_if( result.begin(), result.end(), []( const zone_average & avg ) {
+        return avg.calls == 0.0;
+    } ), result.end() );
+    std::stable_sort( result.begin(), result.end(), []( const zone_average & l,
+    const zone_average & r ) {
+        return l.milliseconds > r.milliseconds;
+    } );
+    return result;
+}
+
+int recorded_turns()
+{
+    return static_cast<int>( state().past_turns.size() );
+}
+
+void write_trace( std::ostream &out )
+{
+    profiler_state &s = state();
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock( s.names_mutex );
+        names = s.zone_names;
+    }
+
+    JsonOut jsout( out );
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    // Oldest first, the ring buffer wraps around at next_zone once it is full
+    const size_t count = s.zones.size();
+    const size_t first = count < max_recorded_zones ? 0 : s.next_zone;
+    for( size_t i = 0; i < count; ++i ) {
+        const recorded_zone &zone = s.zones[( first + i ) % count];
+        jsout.start_object();
+        jsout.member( "name", names[zone.zone] );
+        jsout.member( "cat", "turn" );
+        jsout.member( "ph", "X" );
+        jsout.member( "ts", to_microseconds( zone.start - s.epoch ) );
+        jsout.member( "dur", to_microseconds( zone.duration ) );
+        jsout.member( "pid", 1 );
+        jsout.member( "tid", 1 );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+bool export_trace( const std::string &path )
+{
+    return write_to_file( path, []( std::ostream & fout ) {
+        write_trace( fout );
+    }, nullptr );
+}
+
+void scoped_zone::begin( int id )
+{
+    profiler_state &s = state();
+    if( std::this_thread::get_id() != s.recording_thread ) {
+        return;
+    }
+    zone = id;
+    recording = true;
+    start = clock::now();
+}
+
+void scoped_zone::end()
+{
+    const clock::time_point now = clock::now();
+    profiler_state &s = state();
+    if( !s.is_enabled ) {
+        // Disabled while the zone was running
+        return;
+    }
+    const clock::duration duration = now - start;
+
+    if( s.zones.size() < max_recorded_zones ) {
+        s.zones.push_back( { zone, start, duration } );
+    } else {
+        s.zones[s.next_zone] = { zone, start, duration };
+    }
+    s.next_zone = ( s.next_zone + 1 ) % max_recorded_zones;
+
+    turn_totals &turn = s.current_turn;
+    if( turn.durations.size() <= static_cast<size_t>( zone ) ) {
+        turn.durations.resize( zone + 1, clock::duration::zero() );
+        turn.calls.resize( zone + 1, 0 );
+    }
+    turn.durations[zone] += duration;
+    turn.calls[zone]++;
+}
+
+} // namespace turn_profiler
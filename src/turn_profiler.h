@@ -0,0 +1,105 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Measures how long the phases of a game turn take.
+ *
+ * Phases are marked with @ref CATA_PROFILE_ZONE. While the profiler is enabled every zone
+ * entered on the main thread is recorded, the latest ones are kept for export as a trace
+ * that chrome://tracing or Perfetto can show. Per turn totals of the last few turns are kept
+ * for averages. A disabled profiler costs a single check per zone, building with
+ * CATA_NO_PROFILER removes the zones completely.
+ */
+namespace turn_profiler
+{
+
+using clock = std::chrono::steady_clock;
+
+/** Number of zones kept for the trace, older ones are dropped. */
+constexpr size_t max_recorded_zones = 1 << 16;
+/** Number of turns the averages are taken over. */
+constexpr int averaged_turns = 100;
+
+struct zone_average {
+    std::string name;
+    /** Average time spent in the zone per turn. */
+    double milliseconds = 0.0;
+    /** Longest time spent in the zone in a single turn. */
+    double max_milliseconds = 0.0;
+    /** Average number of times the zone was entered per turn. */
+    double calls = 0.0;
+};
+
+/** Identifies a zone, zones with the same name share it. Called once per zone. */
+int register_zone( const char *name );
+
+/** Starts or stops recording. Zones are recorded on the thread that enabled the profiler. */
+void set_enabled( bool enable );
+bool enabled();
+/** Forgets everything recorded so far. */
+void clear();
+
+/** Ends the turn that is being recorded, its totals go into the averages. */
+void next_turn();
+
+/** Averages over the last @ref averaged_turns turns, most expensive zone first. */
+std::vector<zone_average> averages();
+/** Number of turns the averages are currently taken over. */
+int recorded_turns();
+
+/** Writes the recorded zones in the Trace Event Format. */
+void write_trace( std::ostream &out );
+/** Writes the recorded zones to a trace file at @p path. @return false if that failed. */
+bool export_trace( const std::string &path );
+
+/** Records the time from its construction to its destruction for a zone. */
+class scoped_zone
+{
+    public:
+        explicit scoped_zone( int zone ) {
+            if( enabled() ) {
+                begin( zone );
+            }
+        }
+        ~scoped_zone() {
+            if( recording ) {
+                end();
+            }
+        }
+
+        scoped_zone( const scoped_zone & ) = delete;
+        scoped_zone &operator=( const scoped_zone & ) = delete;
+
+    private:
+        void begin( int id );
+        void end();
+
+        clock::time_point start;
+        int zone = 0;
+        bool recording = false;
+};
+
+} // namespace turn_profiler
+
+#define CATA_PROFILE_ZONE_CONCAT_( a, b ) a##b
+#define CATA_PROFILE_ZONE_CONCAT( a, b ) CATA_PROFILE_ZONE_CONCAT_( a, b )
+
+#if defined(CATA_NO_PROFILER)
+#define CATA_PROFILE_ZONE( name )
+#else
+/** Profiles the rest of the enclosing scope as a zone called @p name, a string literal. */
+#define CATA_PROFILE_ZONE( name ) \
+    static const int CATA_PROFILE_ZONE_CONCAT( profile_zone_id_, __LINE__ ) = \
+            turn_profiler::register_zone( name ); \
+    turn_profiler::scoped_zone CATA_PROFILE_ZONE_CONCAT( profile_zone_, __LINE__ )( \
+            CATA_PROFILE_ZONE_CONCAT( profile_zone_id_, __LINE__ ) )
+#endif
+
+#endif // CATA_SRC_TURN_PROFILER_H
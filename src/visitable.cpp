@@ -602,6 +602,7 @@ std::list<item> visitable<inventory>::remove_items_with( const
 
     // Invalidate binning cache
     inv->binned = false;
+    inv->stacks_indexed = false;
 
     return res;
 }
@@ -1056,9 +1056,29 @@ int weather_manager::get_water_temperature( const tripoint & )
     return water_temperature;
 }
 
+// A couple of years of hours at one place. Catching up many tiles of a long unvisited submap
+// within a single turn would otherwise keep all of them.
+static constexpr size_t max_temperature_history = 2 * 366 * 24;
+
+double weather_manager::get_weather_temperature( const tripoint &location, const time_point &t )
+{
+    const std::pair<tripoint, int> key( location, to_turn<int>( t ) );
+    const auto cached = temperature_history_cache.find( key );
+    if( cached != temperature_history_cache.end() ) {
+        return cached->second;
+    }
+    const double temp = get_cur_weather_gen().get_weather_temperature( location, t, g->get_seed() );
+    if( temperature_history_cache.size() >= max_temperature_history ) {
+        temperature_history_cache.clear();
+    }
+    temperature_history_cache.emplace( key, temp );
+    return temp;
+}
+
 void weather_manager::clear_temp_cache()
 {
     temperature_cache.clear();
+    temperature_history_cache.clear();
 }
 
 namespace weather
@@ -3,6 +3,7 @@
 #define CATA_SRC_WEATHER_H
 
 #include "color.h"
+#include "hash_utils.h"
 #include "optional.h"
 #include "pimpl.h"
 #include "point.h"
@@ -272,10 +273,18 @@ class weather_manager
         time_point nextweather;
         /** temperature cache, cleared every turn, sparse map of map tripoints to temperatures in Fahrenheit */
         std::unordered_map< tripoint, int > temperature_cache;
+        /**
+         * Past outdoor temperatures in Fahrenheit, keyed by location and turn, cleared every turn
+         * and whenever it grows too large. Items stored together look up the same hours when
+         * they catch up on rot.
+         */
+        std::unordered_map<std::pair<tripoint, int>, double, cata::tuple_hash> temperature_history_cache;
         // Returns outdoor or indoor temperature of given location (in local coords) in Fahrenheit.
         int get_temperature( const tripoint &location );
         // Returns water temperature of given location (in local coords) in Fahrenheit.
         int get_water_temperature( const tripoint &location );
+        // Returns the outdoor temperature the weather generator gives for location at time t in Fahrenheit.
+        double get_weather_temperature( const tripoint &location, const time_point &t );
         void clear_temp_cache();
 };
 
@@ -0,0 +1,137 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+worker_pool::worker_pool( const unsigned workers ) : next_task( 0 ), unfinished_tasks( 0 )
+{
+    for( unsigned i = 0; i < workers; ++i ) {
+        this->workers.emplace_back( [this]() {
+            work();
+        } );
+    }
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    work_available.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+unsigned worker_pool::threads() const
+{
+    return static_cast<unsigned>( workers.size() ) + 1;
+}
+
+void worker_pool::run( const size_t count, const std::function<void( size_t )> &task )
+{
+    if( workers.empty() || count <= 1 ) {
+        std::exception_ptr result;
+        for( size_t i = 0; i < count; ++i ) {
+            try {
+                task( i );
+            } catch( ... ) {
+                if( !result ) {
+                    result = std::current_exception();
+                }
+            }
+        }
+        if( result ) {
+            std::rethrow_exception( result );
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        this->task = &task;
+        task_count = count;
+        next_task = 0;
+        unfinished_tasks = count;
+        error = nullptr;
+        job_generation++;
+    }
+    work_available.notify_all();
+    run_tasks();
+
+    std::exception_ptr result;
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        job_done.wait( lock, [this]() {
+            return unfinished_tasks == 0 && busy_workers == 0;
+        } );
+        this->task = nullptr;
+        std::swap( result, error );
+    }
+    if( result ) {
+        std::rethrow_exception( result );
+    }
+}
+
+void worker_pool::run_tasks()
+{
+    while( true ) {
+        const size_t i = next_task++;
+        if( i >= task_count ) {
+            return;
+        }
+        try {
+            ( *task )( i );
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            if( !error ) {
+                error = std::current_exception();
+            }
+        }
+        unfinished_tasks--;
+    }
+}
+
+void worker_pool::work()
+{
+    int seen_generation = 0;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_available.wait( lock, [this, &seen_generation]() {
+            return stopping || ( task != nullptr && job_generation != seen_generation );
+        } );
+        if( stopping ) {
+            return;
+        }
+        seen_generation = job_generation;
+        busy_workers++;
+        lock.unlock();
+        run_tasks();
+        lock.lock();
+        busy_workers--;
+        if( busy_workers == 0 ) {
+            job_done.notify_all();
+        }
+    }
+}
+
+static worker_pool *overridden_pool = nullptr;
+
+worker_pool &get_worker_pool()
+{
+    if( overridden_pool != nullptr ) {
+        return *overridden_pool;
+    }
+    static worker_pool pool( std::max( std::thread::hardware_concurrency(), 1u ) - 1 );
+    return pool;
+}
+
+worker_pool_override::worker_pool_override( worker_pool &pool ) : previous( overridden_pool )
+{
+    overridden_pool = &pool;
+}
+
+worker_pool_override::~worker_pool_override()
+{
+    overridden_pool = previous;
+}
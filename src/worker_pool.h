@@ -0,0 +1,85 @@
+#pragma once
+#ifndef CATA_SRC_WORKER_POOL_H
+#define CATA_SRC_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+#include <vector>
+
+/**
+ * Threads that run the independent parts of an expensive computation.
+ *
+ * The calling thread takes part in the work, so a pool without workers simply runs
+ * everything on the calling thread.
+ */
+class worker_pool
+{
+    public:
+        /** Starts @p workers threads besides the calling one. */
+        explicit worker_pool( unsigned workers );
+        ~worker_pool();
+
+        worker_pool( const worker_pool & ) = delete;
+        worker_pool &operator=( const worker_pool & ) = delete;
+
+        /**
+         * Calls @p task with every index in [0, @p count) and returns when all of the calls
+         * are done. Calls happen on any thread and in any order. The first exception thrown by
+         * a call is rethrown here, after the remaining calls finished.
+         * Must not be called from within a task.
+         */
+        void run( size_t count, const std::function<void( size_t )> &task );
+
+        /** Number of threads that run tasks, including the calling one. */
+        unsigned threads() const;
+
+    private:
+        void work();
+        // Runs tasks of the current job until none are left
+        void run_tasks();
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable job_done;
+        // Current job, only set while run is active
+        const std::function<void( size_t )> *task = nullptr;
+        size_t task_count = 0;
+        std::atomic<size_t> next_task;
+        std::atomic<size_t> unfinished_tasks;
+        // Workers currently running tasks of the current job
+        unsigned busy_workers = 0;
+        int job_generation = 0;
+        std::exception_ptr error;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+};
+
+/** The pool shared by the game, with a worker for each additional hardware thread. */
+worker_pool &get_worker_pool();
+
+/**
+ * Makes @ref get_worker_pool return another pool while it exists, so that tests can run
+ * the parallel code with several threads regardless of the hardware.
+ */
+class worker_pool_override
+{
+    public:
+        explicit worker_pool_override( worker_pool &pool );
+        ~worker_pool_override();
+
+        worker_pool_override( const worker_pool_override & ) = delete;
+        worker_pool_override &operator=( const worker_pool_override & ) = delete;
+
+    private:
+        worker_pool *previous;
+};
+
+#endif // CATA_SRC_WORKER_POOL_H
@@ -24,6 +24,7 @@
 #include "ime.h"
 #include "input.h"
 #include "json.h"
+#include "mapbuffer.h"
 #include "mod_manager.h"
 #include "name.h"
 #include "output.h"
@@ -1643,6 +1644,8 @@ static bool isForbidden( const std::string &candidate )
 
 void worldfactory::delete_world( const std::string &worldname, const bool delete_folder )
 {
+    // Map files may still be written in the background
+    MAPBUFFER.wait_for_saves();
     std::string worldpath = get_world( worldname )->folder_path();
     std::set<std::string> directory_paths;
 
@@ -1,6 +1,9 @@
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "game.h"
@@ -46,3 +49,72 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_items_are_processed_at_the_pace_of_their_speed", "[item]" )
+{
+    active_item_cache cache;
+    std::vector<item> food( 10, item( "apple" ) );
+    std::vector<item> lit( 3, item( "firecracker_act" ) );
+    for( item &it : food ) {
+        cache.add( it, point_zero );
+    }
+    for( item &it : lit ) {
+        it.activate();
+        cache.add( it, point_zero );
+    }
+    // Adding again doesn't process an item twice
+    cache.add( lit[0], point_zero );
+    cache.remove( &lit[2] );
+
+    const int food_interval = food[0].processing_speed();
+    REQUIRE( food_interval > 10 );
+    std::map<const item *, int> times_processed;
+    for( int turn = 0; turn < 2 * food_interval; ++turn ) {
+        for( const item_reference &ref : cache.get_for_processing() ) {
+            times_processed[ref.item_ref.get()]++;
+        }
+        calendar::turn += 1_turns;
+    }
+    // Less food than its speed is processed one item per turn
+    for( const item &it : food ) {
+        CHECK( times_processed[&it] == 2 * food_interval / 10 );
+    }
+    CHECK( times_processed[&lit[0]] == 2 * food_interval );
+    CHECK( times_processed[&lit[1]] == 2 * food_interval );
+    CHECK( times_processed.count( &lit[2] ) == 0 );
+    CHECK( cache.get().size() == 12 );
+}
+
+TEST_CASE( "crowds_of_active_items_are_spread_over_their_speed", "[item]" )
+{
+    active_item_cache cache;
+    item lone( "apple" );
+    cache.add( lone, point_zero );
+    const int food_speed = lone.processing_speed();
+
+    std::map<const item *, int> times_processed;
+    for( int turn = 0; turn < 5; ++turn ) {
+        for( const item_reference &ref : cache.get_for_processing() ) {
+            times_processed[ref.item_ref.get()]++;
+        }
+        calendar::turn += 1_turns;
+    }
+    // Like a single corpse, which gets a chance to revive every turn
+    CHECK( times_processed[&lone] == 5 );
+
+    // With twice as many items as the speed, three of them are processed every turn
+    std::vector<item> crowd( 2 * food_speed - 1, item( "apple" ) );
+    for( item &it : crowd ) {
+        cache.add( it, point_zero );
+    }
+    times_processed.clear();
+    for( int turn = 0; turn < 2 * food_speed; ++turn ) {
+        for( const item_reference &ref : cache.get_for_processing() ) {
+            times_processed[ref.item_ref.get()]++;
+        }
+        calendar::turn += 1_turns;
+    }
+    for( const item &it : crowd ) {
+        CHECK( times_processed[&it] == 3 );
+    }
+}
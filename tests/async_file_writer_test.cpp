@@ -0,0 +1,68 @@
+#include <istream>
+#include <iterator>
+#include <string>
+
+#include "async_file_writer.h"
+#include "catch/catch.hpp"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+
+static std::string read_whole_file( const std::string &path )
+{
+    std::string contents;
+    read_from_file( path, [&contents]( std::istream & fin ) {
+        contents.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    } );
+    return contents;
+}
+
+TEST_CASE( "async_file_writer_writes_latest_contents", "[filesystem]" )
+{
+    const std::string base = g->get_world_base_save_path() + "/async_writer_test_" +
+                             get_pid_string() + "/";
+    REQUIRE( assure_dir_exist( base ) );
+    const std::string first = base + "first.json";
+    const std::string second = base + "second.json";
+
+    async_file_writer writer;
+    writer.queue( first, "[ 1 ]" );
+    writer.queue( second, "[ 2 ]" );
+    writer.queue( first, "[ 3 ]" );
+
+    std::string pending;
+    if( writer.pending_contents( first, pending ) ) {
+        // Either not written yet, or already replaced
+        CHECK( pending == "[ 3 ]" );
+    }
+
+    CHECK( writer.wait().empty() );
+    CHECK_FALSE( writer.pending_contents( first, pending ) );
+    CHECK( read_whole_file( first ) == "[ 3 ]" );
+    CHECK( read_whole_file( second ) == "[ 2 ]" );
+
+    SECTION( "failed writes are reported and kept for another try" ) {
+        const std::string missing = base + "missing_dir/file.json";
+        writer.queue( missing, "[ 4 ]" );
+        CHECK( writer.wait().size() == 1 );
+        CHECK( writer.wait().empty() );
+        CHECK( writer.pending_contents( missing, pending ) );
+        CHECK( pending == "[ 4 ]" );
+
+        writer.retry_failed();
+        CHECK( writer.wait().size() == 1 );
+        CHECK( writer.take_errors().empty() );
+
+        REQUIRE( assure_dir_exist( base + "missing_dir" ) );
+        writer.retry_failed();
+        CHECK( writer.wait().empty() );
+        CHECK_FALSE( writer.is_pending( missing ) );
+        CHECK( read_whole_file( missing ) == "[ 4 ]" );
+        remove_file( missing );
+        remove_directory( base + "missing_dir" );
+    }
+
+    remove_file( first );
+    remove_file( second );
+    remove_directory( base );
+}
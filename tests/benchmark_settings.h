@@ -0,0 +1,14 @@
+#pragma once
+#ifndef CATA_TESTS_BENCHMARK_SETTINGS_H
+#define CATA_TESTS_BENCHMARK_SETTINGS_H
+
+#include <string>
+
+/**
+ * Integer setting of a benchmark, given as --benchmark_settings=name:value[,…] on the
+ * command line of the test runner.
+ * @return @p default_value if the setting wasn't given.
+ */
+int benchmark_setting( const std::string &name, int default_value );
+
+#endif // CATA_TESTS_BENCHMARK_SETTINGS_H
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "cache_kernels.h"
+#include "catch/catch.hpp"
+#include "game_constants.h"
+#include "rng.h"
+#include "shadowcasting.h"
+
+static constexpr size_t map_dimensions = MAPSIZE_X * MAPSIZE_Y;
+
+static std::vector<float> random_cache()
+{
+    std::vector<float> result( map_dimensions );
+    for( float &v : result ) {
+        v = rng_float( 0.0, 1.0 );
+    }
+    return result;
+}
+
+static std::vector<four_quadrants> random_light()
+{
+    std::vector<four_quadrants> result( map_dimensions );
+    for( four_quadrants &v : result ) {
+        for( float &quadrant : v.values ) {
+            quadrant = rng_float( 0.0, 100.0 );
+        }
+    }
+    return result;
+}
+
+// The loops the kernels replaced
+static void plain_max( const std::vector<float> &l, const std::vector<float> &r,
+                       std::vector<float> &out )
+{
+    for( size_t i = 0; i < map_dimensions; ++i ) {
+        out[i] = std::max( l[i], r[i] );
+    }
+}
+
+static void plain_apparent_light( const std::vector<float> &vis,
+                                  const std::vector<four_quadrants> &light, std::vector<float> &out )
+{
+    for( size_t i = 0; i < map_dimensions; ++i ) {
+        out[i] = vis[i] * light[i].max();
+    }
+}
+
+TEST_CASE( "cache_kernels_match_plain_loops", "[shadowcasting]" )
+{
+    const std::vector<float> seen = random_cache();
+    const std::vector<float> camera = random_cache();
+    const std::vector<four_quadrants> light = random_light();
+    std::vector<float> expected( map_dimensions );
+    std::vector<float> result( map_dimensions );
+    // Odd counts leave a remainder after the vectorized part
+    const size_t count = GENERATE( as<size_t> {}, map_dimensions, map_dimensions - 3, 1 );
+    CAPTURE( cache_kernels::vectorized() );
+    CAPTURE( count );
+
+    SECTION( "fill" ) {
+        cache_kernels::fill( result.data(), LIGHT_TRANSPARENCY_OPEN_AIR, count );
+        CHECK( std::all_of( result.begin(), result.begin() + count, []( float v ) {
+            return v == LIGHT_TRANSPARENCY_OPEN_AIR;
+        } ) );
+        CHECK( std::all_of( result.begin() + count, result.end(), []( float v ) {
+            return v == 0.0f;
+        } ) );
+    }
+
+    SECTION( "max" ) {
+        plain_max( seen, camera, expected );
+        cache_kernels::elementwise_max( seen.data(), camera.data(), result.data(), count );
+        CHECK( std::equal( result.begin(), result.begin() + count, expected.begin() ) );
+    }
+
+    SECTION( "apparent light" ) {
+        plain_apparent_light( seen, light, expected );
+        cache_kernels::quadrant_max( light.data(), result.data(), count );
+        cache_kernels::multiply( seen.data(), result.data(), result.data(), count );
+        CHECK( std::equal( result.begin(), result.begin() + count, expected.begin() ) );
+    }
+}
+
+TEST_CASE( "cache_kernels_benchmark", "[.][shadowcasting][benchmark]" )
+{
+    const std::vector<float> seen = random_cache();
+    const std::vector<float> camera = random_cache();
+    const std::vector<four_quadrants> light = random_light();
+    std::vector<float> result( map_dimensions );
+
+    BENCHMARK( "fill, plain" ) {
+        std::fill_n( result.data(), map_dimensions, LIGHT_TRANSPARENCY_OPEN_AIR );
+        return result[0];
+    };
+    BENCHMARK( "fill, kernel" ) {
+        cache_kernels::fill( result.data(), LIGHT_TRANSPARENCY_OPEN_AIR, map_dimensions );
+        return result[0];
+    };
+    BENCHMARK( "seen and camera max, plain" ) {
+        plain_max( seen, camera, result );
+        return result[0];
+    };
+    BENCHMARK( "seen and camera max, kernel" ) {
+        cache_kernels::elementwise_max( seen.data(), camera.data(), result.data(), map_dimensions );
+        return result[0];
+    };
+    BENCHMARK( "apparent light, plain" ) {
+        plain_apparent_light( seen, light, result );
+        return result[0];
+    };
+    BENCHMARK( "apparent light, kernel" ) {
+        cache_kernels::quadrant_max( light.data(), result.data(), map_dimensions );
+        cache_kernels::multiply( seen.data(), result.data(), result.data(), map_dimensions );
+        return result[0];
+    };
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <climits>
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -17,6 +18,7 @@
 #include "crafting.h"
 #include "distribution_grid.h"
 #include "game.h"
+#include "inventory.h"
 #include "item.h"
 #include "itype.h"
 #include "map.h"
@@ -28,14 +30,13 @@
 #include "player_helpers.h"
 #include "point.h"
 #include "recipe.h"
+#include "recipe_availability.h"
 #include "recipe_dictionary.h"
 #include "requirements.h"
 #include "string_id.h"
 #include "type_id.h"
 #include "value_ptr.h"
 
-class inventory;
-
 static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
 static const trait_id trait_DEBUG_STORAGE( "DEBUG_STORAGE" );
 
@@ -589,6 +590,115 @@ TEST_CASE( "debug hammerspace", "[crafting]" )
     }
 }
 
+TEST_CASE( "crafting inventory stacks and bins items from the map", "[crafting][inventory]" )
+{
+    clear_map();
+    clear_avatar();
+    avatar &you = get_avatar();
+    map &here = get_map();
+    const tripoint spot = you.pos() + point_east;
+    for( int i = 0; i < 50; ++i ) {
+        here.add_item( spot, item( "rock" ) );
+        here.add_item( spot, item( "hammer" ) );
+        here.add_item( spot, item( "scrap", calendar::turn, 2 ) );
+    }
+    you.invalidate_crafting_inventory();
+    const inventory &crafting_inv = you.crafting_inventory();
+
+    // Items of a type stack together, charges are merged
+    const auto stacks_of = []( const inventory & inv, const std::string & id ) {
+        const const_invslice stacks = inv.const_slice();
+        return std::count_if( stacks.begin(), stacks.end(), [&id]( const std::list<item> *stack ) {
+            return stack->front().typeId() == itype_id( id );
+        } );
+    };
+    CHECK( stacks_of( crafting_inv, "rock" ) == 1 );
+    CHECK( stacks_of( crafting_inv, "hammer" ) == 1 );
+    CHECK( stacks_of( crafting_inv, "scrap" ) == 1 );
+    CHECK( crafting_inv.charges_of( itype_id( "rock" ) ) == 50 );
+    CHECK( crafting_inv.amount_of( itype_id( "hammer" ) ) == 50 );
+    CHECK( crafting_inv.charges_of( itype_id( "scrap" ) ) == 100 );
+
+    // The bins follow items added later, in a copy as well as in the original
+    inventory copy = crafting_inv;
+    REQUIRE( copy.get_binned_items().at( itype_id( "hammer" ) ).size() == 50 );
+    copy.add_item( item( "rock" ) );
+    copy.add_item( item( "hammer" ) );
+    CHECK( stacks_of( copy, "rock" ) == 1 );
+    CHECK( copy.get_binned_items().at( itype_id( "hammer" ) ).size() == 51 );
+    CHECK( copy.amount_of( itype_id( "hammer" ) ) == 51 );
+    copy.add_item( item( "rock" ) );
+    CHECK( copy.charges_of( itype_id( "rock" ) ) == 52 );
+    CHECK( crafting_inv.charges_of( itype_id( "rock" ) ) == 50 );
+
+    // Items of a character can be transformed in place, adding must not trust the old bins
+    REQUIRE( you.inv.size() == 0 );
+    you.inv.add_item( item( "hammer" ) );
+    REQUIRE( you.inv.get_binned_items().at( itype_id( "hammer" ) ).size() == 1 );
+    you.inv.find_item( 0 ).convert( itype_id( "wrench" ) );
+    you.inv.add_item( item( "wrench" ) );
+    CHECK( stacks_of( you.inv, "wrench" ) == 1 );
+    CHECK( you.inv.get_binned_items().count( itype_id( "hammer" ) ) == 0 );
+    CHECK( you.inv.get_binned_items().at( itype_id( "wrench" ) ).size() == 2 );
+}
+
+TEST_CASE( "recipe availability is only checked again for changed items", "[crafting][recipes]" )
+{
+    clear_avatar();
+    const recipe &carver = recipe_id( "carver_off" ).obj();
+    const recipe &rum = recipe_id( "brew_rum" ).obj();
+    const auto carver_parts = []( bool with_iron ) {
+        inventory inv;
+        inv.add_item( item( "screwdriver" ) );
+        inv.add_item( item( "mold_plastic" ) );
+        for( int i = 0; i < 10; ++i ) {
+            inv.add_item( item( "solder_wire" ) );
+        }
+        for( int i = 0; i < 6; ++i ) {
+            inv.add_item( item( "plastic_chunk" ) );
+        }
+        for( int i = 0; i < 5; ++i ) {
+            inv.add_item( item( "cable" ) );
+        }
+        inv.add_item( item( "blade" ) );
+        inv.add_item( item( "blade" ) );
+        inv.add_item( item( "motor_tiny" ) );
+        inv.add_item( item( "power_supply" ) );
+        inv.add_item( item( "scrap" ) );
+        inv.add_item( item( "hotplate", calendar::start_of_cataclysm, 20 ) );
+        if( with_iron ) {
+            inv.add_item( item( "soldering_iron", calendar::start_of_cataclysm, 20 ) );
+        }
+        return inv;
+    };
+
+    recipe_availability availability;
+    inventory inv = carver_parts( true );
+    availability.update( inv );
+    CHECK( availability.get( carver ).could_craft );
+    CHECK_FALSE( availability.get( rum ).could_craft );
+    CHECK( availability.size() == 2 );
+
+    // Yeast only matters for the rum
+    inv.add_item( item( "yeast" ) );
+    availability.update( inv );
+    CHECK( availability.size() == 1 );
+    CHECK_FALSE( availability.get( rum ).could_craft );
+
+    // Nothing changed
+    availability.update( inv );
+    CHECK( availability.size() == 2 );
+
+    // Without the soldering iron the carver can't be made anymore
+    inventory without_iron = carver_parts( false );
+    without_iron.add_item( item( "yeast" ) );
+    availability.update( without_iron );
+    CHECK( availability.size() == 1 );
+    CHECK_FALSE( availability.get( carver ).could_craft );
+    CHECK( availability.get( carver ).apparently_craftable ==
+           recipe_availability::evaluate( carver, without_iron, 1 ).apparently_craftable );
+}
+
 TEST_CASE( "oven electric grid", "[crafting][overmap][grids][slow]" )
 {
     map &m = g->m;
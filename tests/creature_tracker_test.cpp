@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "creature_tracker.h"
+#include "game.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+
+static bool found_in( const std::vector<monster *> &mons, const monster &mon )
+{
+    return std::find( mons.begin(), mons.end(), &mon ) != mons.end();
+}
+
+TEST_CASE( "creature_tracker_finds_monsters_in_radius", "[creature_tracker]" )
+{
+    clear_map();
+    const Creature_tracker &tracker = *g->critter_tracker;
+    const tripoint center( 60, 60, 0 );
+
+    monster &near = spawn_test_monster( "mon_zombie", center + point( 3, -2 ) );
+    monster &edge = spawn_test_monster( "mon_zombie", center + point( -10, 10 ) );
+    monster &far = spawn_test_monster( "mon_zombie", center + point( 11, 0 ) );
+    monster &other_cell = spawn_test_monster( "mon_zombie", center + point( -25, 0 ) );
+
+    SECTION( "only monsters inside the square radius are returned" ) {
+        const std::vector<monster *> found = tracker.find_in_radius( center, 10 );
+        CHECK( found.size() == 2 );
+        CHECK( found_in( found, near ) );
+        CHECK( found_in( found, edge ) );
+        CHECK_FALSE( found_in( found, far ) );
+        CHECK_FALSE( found_in( found, other_cell ) );
+    }
+
+    SECTION( "moved monsters are found at their new position" ) {
+        far.setpos( center + point( 1, 1 ) );
+        near.setpos( center + point( 30, 30 ) );
+        const std::vector<monster *> found = tracker.find_in_radius( center, 10 );
+        CHECK( found_in( found, far ) );
+        CHECK_FALSE( found_in( found, near ) );
+    }
+
+    SECTION( "removed and dead monsters are not returned" ) {
+        // near must not be touched once it's removed
+        const tripoint removed_pos = near.pos();
+        g->remove_zombie( near );
+        edge.set_hp( 0 );
+        CHECK( tracker.find_in_radius( center, 10 ).empty() );
+        CHECK( tracker.find_in_radius( removed_pos, 0 ).empty() );
+    }
+
+    SECTION( "predicate filters the result" ) {
+        const std::vector<monster *> found = tracker.find_in_radius_if( center, 30, 0,
+        [&]( const monster & mon ) {
+            return &mon != &near;
+        } );
+        CHECK( found.size() == 3 );
+        CHECK_FALSE( found_in( found, near ) );
+    }
+}
@@ -0,0 +1,81 @@
+#include "avatar.h"
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "catch/catch.hpp"
+#include "field.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "type_id.h"
+
+static time_duration web_age( const tripoint &p )
+{
+    const field_entry *web = get_map().field_at( p ).find_field( field_type_id( "fd_web" ) );
+    REQUIRE( web != nullptr );
+    return web->get_field_age();
+}
+
+TEST_CASE( "idle_fields_catch_up", "[field]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint near = g->u.pos() + point_east;
+    // Several submaps away from the player, the only creature around
+    const tripoint far = g->u.pos() + point( SEEX * 4, 0 );
+    here.add_field( near, field_type_id( "fd_web" ), 1, 1_turns );
+    here.add_field( far, field_type_id( "fd_web" ), 1, 1_turns );
+
+    const int was_interval = field_idle_interval;
+    field_idle_interval = 5;
+    for( int turn = 1; turn < 5; ++turn ) {
+        calendar::turn += 1_turns;
+        here.process_fields();
+    }
+    CHECK( web_age( near ) == 5_turns );
+    CHECK( web_age( far ) == 1_turns );
+
+    calendar::turn += 1_turns;
+    here.process_fields();
+    field_idle_interval = was_interval;
+    CHECK( web_age( near ) == 6_turns );
+    CHECK( web_age( far ) == 6_turns );
+}
+
+TEST_CASE( "fields_added_to_idle_submaps_only_catch_up_on_their_own_turns", "[field]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint far = g->u.pos() + point( SEEX * 4, 0 );
+    const tripoint later = far + point_south;
+    here.add_field( far, field_type_id( "fd_web" ), 1, 1_turns );
+
+    restore_on_out_of_scope<int> restore_interval( field_idle_interval );
+    field_idle_interval = 5;
+    for( int turn = 1; turn <= 5; ++turn ) {
+        calendar::turn += 1_turns;
+        if( turn == 3 ) {
+            here.add_field( later, field_type_id( "fd_web" ), 1, 1_turns );
+        }
+        here.process_fields();
+    }
+    CHECK( web_age( far ) == 6_turns );
+    // Added two turns before the submap was processed
+    CHECK( web_age( later ) == 3_turns );
+}
+
+TEST_CASE( "fields_are_not_caught_up_without_idle_skipping", "[field]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint far = g->u.pos() + point( SEEX * 4, 0 );
+    here.add_field( far, field_type_id( "fd_web" ), 1, 1_turns );
+
+    restore_on_out_of_scope<int> restore_interval( field_idle_interval );
+    field_idle_interval = 1;
+    calendar::turn += 10_turns;
+    here.process_fields();
+    CHECK( web_age( far ) == 2_turns );
+}
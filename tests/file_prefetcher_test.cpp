@@ -0,0 +1,50 @@
+#include <ostream>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "file_prefetcher.h"
+#include "filesystem.h"
+#include "fstream_utils.h"
+#include "game.h"
+
+TEST_CASE( "file_prefetcher_reads_requested_files", "[filesystem]" )
+{
+    const std::string base = g->get_world_base_save_path() + "/prefetcher_test_" +
+                             get_pid_string() + "/";
+    REQUIRE( assure_dir_exist( base ) );
+    const std::string path = base + "quad.map";
+    write_to_file( path, []( std::ostream & fout ) {
+        fout << "[ \"contents\" ]";
+    } );
+
+    file_prefetcher prefetcher;
+    std::string contents;
+    bool exists = false;
+
+    SECTION( "requested file is taken once" ) {
+        prefetcher.request( path );
+        // Either read ahead, or not started yet and left to the caller
+        if( prefetcher.take( path, contents, exists ) ) {
+            CHECK( exists );
+            CHECK( contents == "[ \"contents\" ]" );
+        }
+        CHECK_FALSE( prefetcher.take( path, contents, exists ) );
+    }
+
+    SECTION( "missing file is reported as such" ) {
+        const std::string missing = base + "missing.map";
+        prefetcher.request( missing );
+        if( prefetcher.take( missing, contents, exists ) ) {
+            CHECK_FALSE( exists );
+        }
+    }
+
+    SECTION( "discarded file has to be read by the caller" ) {
+        prefetcher.request( path );
+        prefetcher.discard( path );
+        CHECK_FALSE( prefetcher.take( path, contents, exists ) );
+    }
+
+    remove_file( path );
+    remove_directory( base );
+}
@@ -1,13 +1,17 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <string>
 
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "enums.h"
+#include "flag.h"
 #include "item.h"
+#include "item_factory.h"
 #include "itype.h"
 #include "ret_val.h"
+#include "type_id.h"
 #include "units.h"
 #include "value_ptr.h"
 
@@ -157,3 +161,61 @@ TEST_CASE( "stacking_over_time", "[item]" )
         }
     }
 }
+
+TEST_CASE( "item_flags_by_name_and_id", "[item]" )
+{
+    for( const itype *type : item_controller->all() ) {
+        for( const std::string &flag : type->get_flags() ) {
+            INFO( type->get_id() << " " << flag );
+            CHECK( type->has_flag( flag ) );
+            CHECK( type->has_flag( json_flag::find( flag ) ) );
+        }
+    }
+
+    item rock( "rock" );
+    const flag_id trader_avoid = json_flag::find( "TRADER_AVOID" );
+    const flag_id filthy = json_flag::find( "FILTHY" );
+    REQUIRE( trader_avoid.is_valid() );
+    REQUIRE( filthy.is_valid() );
+    CHECK_FALSE( json_flag::find( "NOT_A_FLAG" ).is_valid() );
+
+    CHECK( rock.has_flag( "TRADER_AVOID" ) );
+    CHECK( rock.has_flag( trader_avoid ) );
+    CHECK( rock.has_flag( flag_str_id( "TRADER_AVOID" ) ) );
+    CHECK_FALSE( rock.has_flag( "FILTHY" ) );
+    CHECK_FALSE( rock.has_flag( filthy ) );
+
+    rock.set_flag( "FILTHY" );
+    rock.set_flag( "NOT_A_FLAG" );
+    CHECK( rock.has_flag( "FILTHY" ) );
+    CHECK( rock.has_flag( filthy ) );
+    CHECK( rock.has_flag( "NOT_A_FLAG" ) );
+    CHECK( rock.has_flag( flag_str_id( "NOT_A_FLAG" ) ) );
+
+    rock.unset_flags();
+    CHECK_FALSE( rock.has_flag( filthy ) );
+    CHECK_FALSE( rock.has_flag( "NOT_A_FLAG" ) );
+    CHECK( rock.has_flag( trader_avoid ) );
+}
+
+TEST_CASE( "item_flags_benchmark", "[.][item][benchmark]" )
+{
+    const item rock( "rock" );
+    const std::string trader_avoid = "TRADER_AVOID";
+    const std::string filthy = "FILTHY";
+    const flag_id filthy_id = json_flag::find( filthy );
+    static const flag_str_id flag_TRADER_AVOID( "TRADER_AVOID" );
+
+    BENCHMARK( "flag of the type" ) {
+        return rock.has_flag( trader_avoid );
+    };
+    BENCHMARK( "flag of the type by static id" ) {
+        return rock.has_flag( flag_TRADER_AVOID );
+    };
+    BENCHMARK( "missing flag" ) {
+        return rock.has_flag( filthy );
+    };
+    BENCHMARK( "missing flag by id" ) {
+        return rock.has_flag( filthy_id );
+    };
+}
@@ -2,6 +2,9 @@
 
 #include <list>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "bodypart.h"
 #include "catch/catch.hpp"
@@ -452,3 +455,105 @@ TEST_CASE( "jsonin_get_string", "[json]" )
             R"(       ar")" "\n" ),
         R"("foo\nbar")", 5 );
 }
+
+static_assert( !std::is_constructible<JsonIn, std::string, std::string>::value,
+               "JsonIn must not parse a temporary string it would keep pointers into" );
+static_assert( !std::is_constructible<JsonIn, const char *, json_source_location>::value,
+               "JsonIn must not parse a temporary string it would keep pointers into" );
+
+TEST_CASE( "jsonin_reads_text_and_streams_alike", "[json]" )
+{
+    const std::string json = R"([ "foo", 12, { "bar": true } ], "after")";
+
+    SECTION( "text is parsed in place" ) {
+        JsonIn jsin( json, "<text>" );
+        {
+            JsonArray ja = jsin.get_array();
+            CHECK( ja.get_string( 0 ) == "foo" );
+            CHECK( ja.get_int( 1 ) == 12 );
+            CHECK( ja.get_object( 2 ).get_bool( "bar" ) );
+        }
+        CHECK( jsin.get_string() == "after" );
+        CHECK_THROWS_MATCHES( jsin.get_string(), JsonError,
+                              Catch::Message( "Json error: <text>:EOF: couldn't find end of string, reached EOF." ) );
+    }
+
+    SECTION( "streams are parsed from where they are, and left where parsing stopped" ) {
+        std::istringstream iss( "header\n" + json );
+        std::string header;
+        std::getline( iss, header );
+        {
+            JsonIn jsin( iss );
+            // offsets are those of the stream
+            CHECK( jsin.tell() == 7 );
+            jsin.skip_value();
+        }
+        std::string rest;
+        iss >> rest;
+        CHECK( rest == R"("after")" );
+    }
+
+    SECTION( "a number may end the text" ) {
+        const std::string number = "42";
+        JsonIn jsin( number, "<text>" );
+        CHECK( jsin.get_int() == 42 );
+        CHECK_THROWS_WITH( jsin.get_int(), Catch::Contains( "<text>:EOF" ) );
+    }
+}
+
+TEST_CASE( "jsonobject_member_index", "[json]" )
+{
+    const std::string json = R"({ "zeta": 1, "alpha": 2, "mid": { "inner": 3 }, "beta": 4 })";
+    JsonIn jsin( json, "<text>" );
+    JsonObject jo = jsin.get_object();
+    CHECK( jo.size() == 4 );
+    CHECK( jo.has_member( "mid" ) );
+    CHECK_FALSE( jo.has_member( "inner" ) );
+    CHECK( jo.get_int( "beta" ) == 4 );
+    CHECK( jo.get_int( "missing", 5 ) == 5 );
+
+    // members are visited in the order of their names
+    std::vector<std::string> names;
+    for( const JsonMember &member : jo ) {
+        names.push_back( member.name() );
+    }
+    CHECK( names == std::vector<std::string> { "alpha", "beta", "mid", "zeta" } );
+
+    const std::string duplicate = R"({ "b": 1, "a": 2, "b": 3 })";
+    JsonIn dup_jsin( duplicate, "<text>" );
+    CHECK_THROWS_WITH( dup_jsin.get_object(),
+                       Catch::StartsWith( "Json error: <text>:1:23: duplicate entry in json object" ) );
+}
+
+TEST_CASE( "jsonobject_member_index_benchmark", "[.][json][benchmark]" )
+{
+    std::string json = "[";
+    for( int i = 0; i < 1000; ++i ) {
+        json += i == 0 ? "{" : ", {";
+        for( int m = 0; m < 30; ++m ) {
+            json += string_format( "%s\"member_%d\": %d", m == 0 ? "" : ", ", m, i );
+        }
+        json += "}";
+    }
+    json += "]";
+
+    BENCHMARK( "index objects" ) {
+        JsonIn jsin( json, "<text>" );
+        size_t count = 0;
+        for( JsonObject jo : jsin.get_array() ) {
+            jo.allow_omitted_members();
+            count += jo.size();
+        }
+        return count;
+    };
+    BENCHMARK( "index objects and read members" ) {
+        JsonIn jsin( json, "<text>" );
+        int sum = 0;
+        for( JsonObject jo : jsin.get_array() ) {
+            for( int m = 0; m < 30; ++m ) {
+                sum += jo.get_int( "member_" + std::to_string( m ) );
+            }
+        }
+        return sum;
+    };
+}
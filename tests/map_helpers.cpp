@@ -135,6 +135,7 @@ void set_time( const time_point &time )
 {
     calendar::turn = time;
     g->reset_light_level();
+    g->m.clear_route_cache();
     int z = g->u.posz();
     g->m.update_visibility_cache( z );
     g->m.invalidate_map_cache( z );
@@ -1,4 +1,6 @@
+#include <cstddef>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "avatar.h"
@@ -8,6 +10,7 @@
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -88,3 +91,60 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     g->place_player( tripoint_zero );
     CHECK( g->m.check_submap_active_item_consistency().empty() );
 }
+
+TEST_CASE( "map_string_flags_by_index", "[map]" )
+{
+    for( size_t i = 0; i < ter_t::count(); ++i ) {
+        const ter_t &t = ter_id( static_cast<int>( i ) ).obj();
+        for( const std::string &flag : t.get_flags() ) {
+            INFO( t.id.str() << " " << flag );
+            CHECK( t.has_flag( flag ) );
+        }
+    }
+    for( size_t i = 0; i < furn_t::count(); ++i ) {
+        const furn_t &f = furn_id( static_cast<int>( i ) ).obj();
+        for( const std::string &flag : f.get_flags() ) {
+            INFO( f.id.str() << " " << flag );
+            CHECK( f.has_flag( flag ) );
+        }
+    }
+    CHECK( map_data_common_t::flag_index( "NOT_A_FLAG" ) == -1 );
+
+    clear_map();
+    map &here = get_map();
+    const tripoint p( 60, 60, 0 );
+    here.ter_set( p, t_dirt );
+    here.furn_set( p, f_null );
+    CHECK( here.has_flag( "DIGGABLE", p ) );
+    CHECK( here.has_flag_ter( "DIGGABLE", p ) );
+    CHECK_FALSE( here.has_flag_furn( "DIGGABLE", p ) );
+    CHECK_FALSE( here.has_flag( "NOT_A_FLAG", p ) );
+
+    const ter_furn_flag diggable( "DIGGABLE" );
+    const ter_furn_flag unused( "NOT_A_FLAG_OF_ANY_TERRAIN" );
+    CHECK( diggable.index == map_data_common_t::flag_index( "DIGGABLE" ) );
+    CHECK( here.has_flag( diggable, p ) );
+    CHECK( here.has_flag_ter( diggable, p ) );
+    CHECK_FALSE( here.has_flag_furn( diggable, p ) );
+    CHECK_FALSE( here.has_flag( unused, p ) );
+}
+
+TEST_CASE( "map_flags_benchmark", "[.][map][benchmark]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint p( 60, 60, 0 );
+    here.ter_set( p, t_dirt );
+    const std::string diggable = "DIGGABLE";
+    static const ter_furn_flag flag_DIGGABLE( "DIGGABLE" );
+
+    BENCHMARK( "string flag" ) {
+        return here.has_flag( diggable, p );
+    };
+    BENCHMARK( "string flag by index" ) {
+        return here.has_flag( flag_DIGGABLE, p );
+    };
+    BENCHMARK( "ter_bitflag" ) {
+        return here.has_flag( TFLAG_DIGGABLE, p );
+    };
+}
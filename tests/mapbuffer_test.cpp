@@ -0,0 +1,130 @@
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "mapbuffer.h"
+#include "point.h"
+#include "submap.h"
+
+TEST_CASE( "mapbuffer_stores_and_iterates_submaps", "[mapbuffer]" )
+{
+    mapbuffer buffer;
+    // Spread over several chunks, including negative coordinates and chunk edges
+    const std::vector<tripoint> positions = {
+        tripoint_zero, tripoint( -1, -1, 0 ), tripoint( 31, 32, 0 ), tripoint( 32, 31, 0 ),
+        tripoint( -33, 64, -2 ), tripoint( 1000, -1000, 5 ), tripoint( 31, 32, 1 )
+    };
+    std::map<tripoint, submap *> added;
+    for( const tripoint &p : positions ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        submap *raw = sm.get();
+        REQUIRE( buffer.add_submap( p, sm ) );
+        CHECK( sm == nullptr );
+        added[p] = raw;
+    }
+    CHECK( buffer.size() == positions.size() );
+
+    for( const tripoint &p : positions ) {
+        CHECK( buffer.lookup_submap( p ) == added[p] );
+    }
+
+    std::unique_ptr<submap> duplicate = std::make_unique<submap>();
+    CHECK_FALSE( buffer.add_submap( tripoint( 31, 32, 0 ), duplicate ) );
+    CHECK( duplicate != nullptr );
+    CHECK( buffer.lookup_submap( tripoint( 31, 32, 0 ) ) == added[tripoint( 31, 32, 0 )] );
+
+    std::map<tripoint, submap *> iterated;
+    for( const auto &elem : buffer ) {
+        CHECK( iterated.emplace( elem.first, elem.second ).second );
+    }
+    CHECK( iterated == added );
+
+    // Alone in its chunk, removing it drops the chunk
+    buffer.remove_submap( tripoint( 1000, -1000, 5 ) );
+    buffer.remove_submap( tripoint( 31, 32, 0 ) );
+    CHECK( buffer.size() == positions.size() - 2 );
+    CHECK( buffer.lookup_submap( tripoint( 32, 31, 0 ) ) == added[tripoint( 32, 31, 0 )] );
+    CHECK( buffer.lookup_submap( tripoint( 31, 32, 1 ) ) == added[tripoint( 31, 32, 1 )] );
+    std::unique_ptr<submap> readded = std::make_unique<submap>();
+    submap *const readded_raw = readded.get();
+    CHECK( buffer.add_submap( tripoint( 1000, -1000, 5 ), readded ) );
+    CHECK( buffer.lookup_submap( tripoint( 1000, -1000, 5 ) ) == readded_raw );
+
+    buffer.reset();
+    CHECK( buffer.size() == 0 );
+    CHECK( buffer.begin() == buffer.end() );
+}
+
+// Long-running worlds end up with tens of thousands of loaded submaps
+TEST_CASE( "mapbuffer_benchmark", "[.][mapbuffer][benchmark]" )
+{
+    constexpr int side = 100;
+    mapbuffer buffer;
+    for( int x = 0; x < side; x++ ) {
+        for( int y = 0; y < side; y++ ) {
+            std::unique_ptr<submap> sm = std::make_unique<submap>();
+            buffer.add_submap( tripoint( x - side / 2, y - side / 2, 0 ), sm );
+        }
+    }
+    REQUIRE( buffer.size() == side * side );
+
+    BENCHMARK( "lookup scattered" ) {
+        int found = 0;
+        for( int i = 0; i < side * side; i += 7 ) {
+            found += buffer.lookup_submap( tripoint( i % side - side / 2, i / side - side / 2, 0 ) ) != nullptr;
+        }
+        return found;
+    };
+    BENCHMARK( "lookup reality bubble" ) {
+        // Same access pattern as map::loadn walking the bubble
+        int found = 0;
+        for( int x = 0; x < 11; x++ ) {
+            for( int y = 0; y < 11; y++ ) {
+                found += buffer.lookup_submap( tripoint( x, y, 0 ) ) != nullptr;
+            }
+        }
+        return found;
+    };
+    BENCHMARK( "iterate" ) {
+        int count = 0;
+        for( const auto &elem : buffer ) {
+            count += elem.second != nullptr;
+        }
+        return count;
+    };
+    BENCHMARK( "insert and reset 10000" ) {
+        // Includes allocating the submaps, as loading them from disk would
+        mapbuffer scratch;
+        for( int i = 0; i < side * side; i++ ) {
+            std::unique_ptr<submap> sm = std::make_unique<submap>();
+            scratch.add_submap( tripoint( i % side, i / side, 1 ), sm );
+        }
+        const size_t added = scratch.size();
+        scratch.reset();
+        return added;
+    };
+    BENCHMARK_ADVANCED( "remove 10000" )( Catch::Benchmark::Chronometer meter ) {
+        // Each run needs a full buffer to remove from, filled outside of the measurement
+        std::vector<std::unique_ptr<mapbuffer>> scratch( meter.runs() );
+        for( std::unique_ptr<mapbuffer> &buf : scratch ) {
+            buf = std::make_unique<mapbuffer>();
+            for( int i = 0; i < side * side; i++ ) {
+                std::unique_ptr<submap> sm = std::make_unique<submap>();
+                buf->add_submap( tripoint( i % side, i / side, 1 ), sm );
+            }
+        }
+        meter.measure( [&]( int run ) {
+            mapbuffer &buf = *scratch[run];
+            // Same order as saving removes them, quad by quad
+            for( int x = 0; x < side; x += 2 ) {
+                for( int y = 0; y < side; y += 2 ) {
+                    for( const point &offset : { point_zero, point_south, point_east, point_south_east } ) {
+                        buf.remove_submap( tripoint( x + offset.x, y + offset.y, 1 ) );
+                    }
+                }
+            }
+            return buf.size();
+        } );
+    };
+}
@@ -9,6 +9,8 @@
 #include <utility>
 
 #include "avatar.h"
+#include "cached_options.h"
+#include "cata_utility.h"
 #include "catch/catch.hpp"
 #include "game.h"
 #include "map.h"
@@ -17,11 +19,16 @@
 #include "options_helpers.h"
 #include "options.h"
 #include "player.h"
+#include "player_helpers.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "sounds.h"
 #include "test_statistics.h"
 #include "game_constants.h"
 #include "item.h"
 #include "line.h"
 #include "point.h"
+#include "worker_pool.h"
 
 using move_statistics = statistics<int>;
 
@@ -329,3 +336,55 @@ TEST_CASE( "monster_speed_trig", "[speed]" )
     trigdist = true;
     monster_check();
 }
+
+// Where a crowd of zombies ends up after chasing the player for a few turns
+static std::vector<tripoint> zombie_crowd_positions( unsigned int seed )
+{
+    // Same start every time, the turn, the scent and the sounds left by earlier turns steer the zombies
+    clear_map();
+    clear_avatar();
+    const tripoint center = g->u.pos();
+    // An empty turn first, so the weather and the hordes are caught up before the dice are seeded.
+    // What earlier tests left behind still reaches the avatar in it, so it is cleared again after.
+    const time_point start = calendar::turn_zero + 12_hours;
+    set_time( start );
+    sounds::reset_sounds();
+    g->u.set_moves( 0 );
+    REQUIRE_FALSE( g->do_turn() );
+    set_time( start );
+    clear_avatar();
+    g->scent.reset();
+    sounds::reset_sounds();
+    rng_set_engine_seed( seed );
+    for( int i = 0; i < 30; ++i ) {
+        spawn_test_monster( "mon_zombie", center + point( -15 + i % 10 * 3, 20 + i / 10 * 2 ) );
+    }
+    for( int turn = 0; turn < 10; ++turn ) {
+        g->u.set_moves( 0 );
+        REQUIRE_FALSE( g->do_turn() );
+    }
+    std::vector<tripoint> positions;
+    for( const monster &critter : g->all_monsters() ) {
+        positions.push_back( critter.pos() );
+    }
+    return positions;
+}
+
+TEST_CASE( "parallel_monster_planning_matches_serial_planning", "[monster]" )
+{
+    restore_on_out_of_scope<bool> restore_parallel( parallel_monster_planning );
+    parallel_monster_planning = true;
+
+    std::vector<tripoint> serial;
+    {
+        // Without workers every monster plans on this thread, one after another
+        worker_pool pool( 0 );
+        const worker_pool_override use_pool( pool );
+        serial = zombie_crowd_positions( 1234 );
+    }
+    worker_pool pool( 3 );
+    const worker_pool_override use_pool( pool );
+    const std::vector<tripoint> parallel = zombie_crowd_positions( 1234 );
+    CHECK( serial.size() == 30 );
+    CHECK( serial == parallel );
+}
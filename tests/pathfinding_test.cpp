@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "line.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "point.h"
+
+static const pathfinding_settings test_settings( 0, 1000, 1000, 0, false, false, true, false,
+        false );
+
+// Reference map: open ground crossed by walls with single gaps at alternating ends,
+// so routes through it have to snake around instead of taking the straight line.
+static void build_maze()
+{
+    clear_map();
+    map &here = get_map();
+    for( int x = 25; x < MAPSIZE_X - 20; x += 10 ) {
+        const int gap = ( x / 10 ) % 2 == 0 ? 46 : 74;
+        for( int y = 45; y <= 75; y++ ) {
+            if( y != gap ) {
+                here.ter_set( tripoint( x, y, 0 ), t_wall );
+            }
+        }
+    }
+}
+
+static bool path_is_walkable( const std::vector<tripoint> &path, const tripoint &from )
+{
+    tripoint prev = from;
+    for( const tripoint &p : path ) {
+        if( square_dist( prev, p ) != 1 || get_map().impassable( p ) ) {
+            return false;
+        }
+        prev = p;
+    }
+    return true;
+}
+
+TEST_CASE( "route_goes_around_walls", "[pathfinding]" )
+{
+    build_maze();
+    map &here = get_map();
+    const tripoint from( 15, 60, 0 );
+    const tripoint to( 50, 60, 0 );
+
+    const std::vector<tripoint> path = here.route( from, to, test_settings );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    CHECK( path_is_walkable( path, from ) );
+    // The straight line is blocked, the route has to go through the gaps
+    CHECK( path.size() > static_cast<size_t>( rl_dist( from, to ) ) );
+
+    SECTION( "reused search state does not leak between routes" ) {
+        // A failed search leaves closed nodes behind in the pooled state
+        const tripoint walled_in( 5, 5, 0 );
+        for( const tripoint &p : get_map().points_in_radius( walled_in, 1 ) ) {
+            if( p != walled_in ) {
+                get_map().ter_set( p, t_wall );
+            }
+        }
+        CHECK( here.route( from, walled_in, test_settings ).empty() );
+
+        // Searched again instead of taken from the route cache
+        here.clear_route_cache();
+        CHECK( here.route( from, to, test_settings ) == path );
+        const std::vector<tripoint> back = here.route( to, from, test_settings );
+        REQUIRE_FALSE( back.empty() );
+        CHECK( back.back() == from );
+        CHECK( path_is_walkable( back, to ) );
+    }
+}
+
+TEST_CASE( "cached_routes_follow_map_changes", "[pathfinding]" )
+{
+    build_maze();
+    map &here = get_map();
+    const tripoint from( 15, 60, 0 );
+    const tripoint to( 50, 60, 0 );
+
+    const std::vector<tripoint> path = here.route( from, to, test_settings );
+    REQUIRE_FALSE( path.empty() );
+
+    SECTION( "blocking the cached route forces a new one" ) {
+        const tripoint blocked = path[path.size() / 2];
+        here.ter_set( blocked, t_wall );
+        const std::vector<tripoint> rerouted = here.route( from, to, test_settings );
+        REQUIRE_FALSE( rerouted.empty() );
+        CHECK( path_is_walkable( rerouted, from ) );
+        CHECK( std::find( rerouted.begin(), rerouted.end(), blocked ) == rerouted.end() );
+    }
+
+    SECTION( "opening a shortcut is noticed" ) {
+        for( int x = 25; x <= 55; x += 10 ) {
+            here.ter_set( tripoint( x, 60, 0 ), t_dirt );
+        }
+        CHECK( here.route( from, to, test_settings ).size() ==
+               static_cast<size_t>( rl_dist( from, to ) ) );
+    }
+
+    SECTION( "many routes to one target share a walkable flow field" ) {
+        for( int y = 50; y <= 70; y += 2 ) {
+            const tripoint start( 15, y, 0 );
+            const std::vector<tripoint> route = here.route( start, to, test_settings );
+            REQUIRE_FALSE( route.empty() );
+            CHECK( route.back() == to );
+            CHECK( path_is_walkable( route, start ) );
+        }
+    }
+}
+
+TEST_CASE( "long_routes_cross_the_whole_bubble", "[pathfinding]" )
+{
+    build_maze();
+    map &here = get_map();
+    const tripoint from( 5, 60, 0 );
+    const tripoint to( MAPSIZE_X - 5, 60, 0 );
+
+    const std::vector<tripoint> path = here.route( from, to, test_settings );
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    CHECK( path_is_walkable( path, from ) );
+
+    SECTION( "blocking the route where it crosses a wall finds another way" ) {
+        const auto crossing = std::find_if( path.begin(), path.end(), []( const tripoint & p ) {
+            return p.x == 55;
+        } );
+        REQUIRE( crossing != path.end() );
+        for( int y = crossing->y - 1; y <= crossing->y + 1; y++ ) {
+            here.ter_set( tripoint( 55, y, 0 ), t_wall );
+        }
+
+        const std::vector<tripoint> rerouted = here.route( from, to, test_settings );
+        REQUIRE_FALSE( rerouted.empty() );
+        CHECK( rerouted.back() == to );
+        CHECK( path_is_walkable( rerouted, from ) );
+        CHECK( std::find( rerouted.begin(), rerouted.end(), *crossing ) == rerouted.end() );
+    }
+}
+
+TEST_CASE( "flow_field_routes_stay_in_the_search_box", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // The only way around the wall is far outside the box a route search covers
+    for( int y = 11; y <= 110; y++ ) {
+        here.ter_set( tripoint( 50, y, 0 ), t_wall );
+    }
+    const tripoint to( 60, 60, 0 );
+    const int pad = 16;
+
+    for( int y = 56; y <= 64; y++ ) {
+        const tripoint start( 40, y, 0 );
+        const std::vector<tripoint> route = here.route( start, to, test_settings );
+        for( const tripoint &p : route ) {
+            CHECK( p.y >= std::min( start.y, to.y ) - pad );
+            CHECK( p.y <= std::max( start.y, to.y ) + pad );
+        }
+    }
+}
+
+TEST_CASE( "portal_clusters_are_dirtied_only_near_changes", "[pathfinding]" )
+{
+    submap_portals portals( MAPSIZE );
+    portal_layer &layer = portals.get_layer( 0, test_settings );
+    const auto dirty_clusters = [&layer]() {
+        int count = 0;
+        for( portal_cluster &cluster : layer.clusters ) {
+            count += cluster.dirty ? 1 : 0;
+            cluster.dirty = false;
+        }
+        return count;
+    };
+    dirty_clusters();
+
+    // Four submaps under a vehicle and the eight around them that share an edge
+    portals.invalidate( tripoint( SEEX * 3 + 6, SEEY * 3 + 6, 0 ),
+                        tripoint( SEEX * 4 + 2, SEEY * 4 + 2, 0 ) );
+    CHECK( dirty_clusters() == 12 );
+
+    portals.invalidate( tripoint( SEEX * 3, SEEY * 3, 1 ), tripoint( SEEX * 4, SEEY * 4, 1 ) );
+    CHECK( dirty_clusters() == 0 );
+
+    portals.invalidate( 0 );
+    CHECK( dirty_clusters() == MAPSIZE * MAPSIZE );
+}
+
+TEST_CASE( "route_benchmark", "[.][pathfinding][benchmark]" )
+{
+    build_maze();
+    map &here = get_map();
+    const tripoint from( 12, 12, 0 );
+    const tripoint to( MAPSIZE_X - 12, MAPSIZE_Y - 12, 0 );
+    REQUIRE_FALSE( here.route( from, to, test_settings ).empty() );
+    // Through the gap at the far end of the first wall
+    const tripoint short_from( 20, 60, 0 );
+    const tripoint short_to( 30, 60, 0 );
+    REQUIRE( here.route( short_from, short_to, test_settings ).size() >
+             static_cast<size_t>( rl_dist( short_from, short_to ) ) );
+
+    // The route cache would answer every run after the first without searching
+    BENCHMARK( "route across maze" ) {
+        here.clear_route_cache();
+        return here.route( from, to, test_settings ).size();
+    };
+    BENCHMARK( "short route around a wall" ) {
+        here.clear_route_cache();
+        return here.route( short_from, short_to, test_settings ).size();
+    };
+}
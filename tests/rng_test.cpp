@@ -77,3 +77,48 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "rng_engine_override_replaces_shared_engine" )
+{
+    const auto draw = []() {
+        std::vector<int> values;
+        for( int i = 0; i < 10; ++i ) {
+            values.push_back( rng( 0, 1000000 ) );
+        }
+        return values;
+    };
+    cata_default_random_engine first_engine( 42 );
+    cata_default_random_engine second_engine( 42 );
+    std::vector<int> first;
+    {
+        rng_engine_override use_engine( first_engine );
+        first = draw();
+        CHECK( &rng_get_engine() == &first_engine );
+    }
+    CHECK( &rng_get_engine() != &first_engine );
+    rng_engine_override use_engine( second_engine );
+    CHECK( draw() == first );
+}
+
+TEST_CASE( "rng_engine_override_drops_spare_normal_values" )
+{
+    const auto draw = []() {
+        std::vector<double> values;
+        for( int i = 0; i < 3; ++i ) {
+            values.push_back( normal_roll( 0.0, 1.0 ) );
+        }
+        return values;
+    };
+    cata_default_random_engine first_engine( 42 );
+    cata_default_random_engine second_engine( 42 );
+    std::vector<double> first;
+    {
+        rng_engine_override use_engine( first_engine );
+        first = draw();
+    }
+    // Normal values come in pairs, a value left over from another engine must not come out
+    normal_roll( 0.0, 1.0 );
+    normal_roll( 0.0, 1.0 );
+    rng_engine_override use_engine( second_engine );
+    CHECK( draw() == first );
+}
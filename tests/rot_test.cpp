@@ -1,8 +1,11 @@
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "enums.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -116,3 +119,36 @@ TEST_CASE( "Items rot away" )
         CHECK( m.i_at( loc ).empty() );
     }
 }
+
+TEST_CASE( "Items catching up on rot share the hourly temperatures", "[rot]" )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+
+    item early_item( "meat_cooked" );
+    early_item.process( nullptr, tripoint_zero, false, 1, temperature_flag::TEMP_FREEZER );
+    calendar::turn += 20_minutes;
+    item late_item( "meat_cooked" );
+    late_item.process( nullptr, tripoint_zero, false, 1, temperature_flag::TEMP_FREEZER );
+
+    calendar::turn += 2_days;
+    get_weather().clear_temp_cache();
+    std::unordered_map<std::pair<tripoint, int>, double, cata::tuple_hash> &history =
+        get_weather().temperature_history_cache;
+
+    CHECK_FALSE( early_item.process_rot( 1, false, tripoint_zero, nullptr,
+                                         temperature_flag::TEMP_FREEZER ) );
+    const size_t looked_up = history.size();
+    CHECK( looked_up >= 46 );
+    for( const auto &entry : history ) {
+        CHECK( entry.first.second % to_turns<int>( 1_hours ) == 0 );
+    }
+
+    // The second item was stored at another time, but looks up the same hours
+    CHECK_FALSE( late_item.process_rot( 1, false, tripoint_zero, nullptr,
+                                        temperature_flag::TEMP_FREEZER ) );
+    CHECK( history.size() == looked_up );
+    CHECK( early_item.get_rot() == 0_turns );
+    CHECK( late_item.get_rot() == 0_turns );
+}
@@ -0,0 +1,134 @@
+#include <array>
+
+#include "catch/catch.hpp"
+#include "character.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "point.h"
+#include "scent_map.h"
+
+namespace
+{
+
+class test_scent_map : public scent_map
+{
+    public:
+        test_scent_map() : scent_map( *g ) { }
+
+        using scent_map::scent_array;
+
+        const scent_array<int> &values() const {
+            return grscent;
+        }
+};
+
+// The diffusion as it was written before it only looked at squares near scent
+void reference_update( test_scent_map::scent_array<int> &scent, const tripoint &center, map &m )
+{
+    constexpr int radius = 40;
+    const int diffusivity = 100;
+    test_scent_map::scent_array<int> sum_3_scent_y;
+    test_scent_map::scent_array<int> squares_used_y;
+    const auto blocks = [&]( int x, int y ) {
+        return m.has_flag( TFLAG_NO_SCENT, tripoint( x, y, center.z ) );
+    };
+    const auto reduces = [&]( int x, int y ) {
+        return m.has_flag( TFLAG_REDUCE_SCENT, tripoint( x, y, center.z ) );
+    };
+    for( int x = center.x - radius - 1; x <= center.x + radius + 1; ++x ) {
+        for( int y = center.y - radius; y <= center.y + radius; ++y ) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks( x, i ) ) {
+                    const int weight = reduces( x, i ) ? 2 : 10;
+                    sum_3_scent_y[y][x] += weight * scent[x][i];
+                    squares_used_y[y][x] += weight;
+                }
+            }
+        }
+    }
+    for( int x = center.x - radius; x <= center.x + radius; ++x ) {
+        for( int y = center.y - radius; y <= center.y + radius; ++y ) {
+            int &scent_here = scent[x][y];
+            if( blocks( x, y ) ) {
+                scent_here = 0;
+                continue;
+            }
+            const int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] +
+                                     squares_used_y[y][x + 1];
+            const int this_diffusivity = reduces( x, y ) ? diffusivity / 5 : diffusivity;
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            scent_here = ( temp_scent + this_diffusivity * ( sum_3_scent_y[y][x - 1] +
+                           sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1] ) ) / ( 1000 * 10 );
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE( "scent_diffusion_matches_reference", "[scent]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+
+    // A room with a window, and some walls crossing the scent trail
+    for( int i = -6; i <= 6; ++i ) {
+        here.ter_set( center + point( i, -6 ), t_wall );
+        here.ter_set( center + point( i, 6 ), t_wall );
+        here.ter_set( center + point( -6, i ), t_wall );
+    }
+    here.ter_set( center + point( -6, 0 ), t_window );
+    here.ter_set( center + point( 10, 3 ), t_wall );
+    here.ter_set( center + point( 11, 3 ), t_window );
+
+    test_scent_map scent;
+    scent.reset();
+    test_scent_map::scent_array<int> expected = scent.values();
+    for( int turn = 0; turn < 30; ++turn ) {
+        const tripoint trail = center + point( turn % 12 - 3, turn % 5 - 2 );
+        scent.set( trail, 500 );
+        expected[trail.x][trail.y] = 500;
+
+        scent.update( center, here );
+        reference_update( expected, center, here );
+
+        if( turn == 15 ) {
+            // Opening the room changes what blocks scent
+            here.ter_set( center + point( -6, 2 ), t_floor );
+            here.ter_set( center + point( -6, -2 ), t_window );
+        }
+    }
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            CAPTURE( x, y );
+            REQUIRE( scent.values()[x][y] == expected[x][y] );
+        }
+    }
+}
+
+TEST_CASE( "scent_diffusion_benchmark", "[.][scent][benchmark]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint center = get_player_character().pos();
+    test_scent_map scent;
+    scent.reset();
+
+    BENCHMARK( "no scent" ) {
+        scent.update( center, here );
+        return scent.values()[center.x][center.y];
+    };
+    for( int i = -SEEX; i <= SEEX; ++i ) {
+        scent.set( center + point( i, i ), 1000 );
+    }
+    BENCHMARK( "scent trail" ) {
+        scent.update( center, here );
+        return scent.values()[center.x][center.y];
+    };
+}
@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <vector>
+
+#include "calendar.h"
 #include "catch/catch.hpp"
+#include "field.h"
+#include "field_type.h"
 #include "submap.h"
 #include "game_constants.h"
 #include "int_id.h"
@@ -88,3 +94,34 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_field_tiles", "[submap][field]" )
+{
+    submap sm;
+    const auto add_fire = [&sm]( const point & p ) {
+        sm.get_field( p ).add_field( fd_fire, 1, 0_turns );
+        sm.mark_field_tile( p );
+    };
+    add_fire( point( 5, 3 ) );
+    add_fire( point( 0, 7 ) );
+    add_fire( point( 5, 1 ) );
+    add_fire( point( 0, 7 ) );
+
+    // Sorted the way field processing visits tiles, without duplicates
+    const std::vector<point> expected{ point( 0, 7 ), point( 5, 1 ), point( 5, 3 ) };
+    CHECK( sm.field_tiles == expected );
+
+    sm.rebuild_field_tiles();
+    CHECK( sm.field_tiles == expected );
+
+    sm.rotate( 1 );
+    std::vector<point> rotated;
+    for( const point &p : expected ) {
+        rotated.push_back( p.rotate( 1, { SEEX, SEEY } ) );
+    }
+    std::sort( rotated.begin(), rotated.end() );
+    CHECK( sm.field_tiles == rotated );
+    for( const point &p : sm.field_tiles ) {
+        CHECK( sm.get_field( p ).find_field( fd_fire ) != nullptr );
+    }
+}
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "avatar.h"
+#include "benchmark_settings.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "color.h"
@@ -196,29 +197,47 @@ static name_value_pair_t split_pair( const std::string &s, const char sep )
     }
 }
 
-static option_overrides_t extract_option_overrides( std::vector<const char *> &arg_vec )
+static option_overrides_t benchmark_settings;
+
+static option_overrides_t extract_name_value_pairs( std::vector<const char *> &arg_vec,
+        const std::string &tag )
 {
     option_overrides_t ret;
-    std::string option_overrides_string = extract_argument( arg_vec, "--option_overrides=" );
-    if( option_overrides_string.empty() ) {
+    std::string pairs_string = extract_argument( arg_vec, tag );
+    if( pairs_string.empty() ) {
         return ret;
     }
     const char delim = ',';
     const char sep = ':';
     size_t i = 0;
-    size_t pos = option_overrides_string.find( delim );
+    size_t pos = pairs_string.find( delim );
     while( pos != std::string::npos ) {
-        std::string part = option_overrides_string.substr( i, pos );
+        std::string part = pairs_string.substr( i, pos );
         ret.emplace_back( split_pair( part, sep ) );
         i = ++pos;
-        pos = option_overrides_string.find( delim, pos );
+        pos = pairs_string.find( delim, pos );
     }
     // Handle last part
-    const std::string part = option_overrides_string.substr( i );
+    const std::string part = pairs_string.substr( i );
     ret.emplace_back( split_pair( part, sep ) );
     return ret;
 }
 
+static option_overrides_t extract_option_overrides( std::vector<const char *> &arg_vec )
+{
+    return extract_name_value_pairs( arg_vec, "--option_overrides=" );
+}
+
+int benchmark_setting( const std::string &name, int default_value )
+{
+    for( const name_value_pair_t &setting : benchmark_settings ) {
+        if( setting.first == name ) {
+            return std::stoi( setting.second );
+        }
+    }
+    return default_value;
+}
+
 static std::string extract_user_dir( std::vector<const char *> &arg_vec )
 {
     std::string option_user_dir = extract_argument( arg_vec, "--user-dir=" );
@@ -270,6 +289,7 @@ int main( int argc, const char *argv[] )
     }
 
     option_overrides_t option_overrides_for_test_suite = extract_option_overrides( arg_vec );
+    benchmark_settings = extract_name_value_pairs( arg_vec, "--benchmark_settings=" );
 
     const bool dont_save = check_remove_flags( arg_vec, { "-D", "--drop-world" } );
 
@@ -284,6 +304,7 @@ int main( int argc, const char *argv[] )
         cata_printf( "  -D, --drop-world             Don't save the world on test failure.\n" );
         cata_printf( "  --option_overrides=n:v[,…]   Name-value pairs of game options for tests.\n" );
         cata_printf( "                               (overrides config/options.json values)\n" );
+        cata_printf( "  --benchmark_settings=n:v[,…] Name-value pairs of settings for benchmarks.\n" );
         return result;
     }
 
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "benchmark_settings.h"
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "field_type.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "turn_profiler.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+// Walls and furniture around origin, set on fire in a few places
+static void build_burning_house( const tripoint &origin )
+{
+    map &here = get_map();
+    constexpr int size = 8;
+    for( int x = 0; x <= size; ++x ) {
+        for( int y = 0; y <= size; ++y ) {
+            const tripoint p = origin + point( x, y );
+            const bool wall = x == 0 || y == 0 || x == size || y == size;
+            here.ter_set( p, wall ? t_wall : t_floor );
+            if( !wall && ( x + y ) % 3 == 0 ) {
+                here.furn_set( p, furn_str_id( "f_table" ) );
+            }
+        }
+    }
+    here.add_field( origin + point( 2, 2 ), fd_fire, 3 );
+    here.add_field( origin + point( 5, 6 ), fd_fire, 3 );
+    here.add_field( origin + point( size, 4 ), fd_fire, 3 );
+}
+
+/**
+ * Runs whole turns of the game with a busy reality bubble and reports how fast they were.
+ * Settings, given with --benchmark_settings=name:value[,…]:
+ * zombies, npcs - number of them around the player
+ * turns - number of turns measured
+ * seed - random seed, for turns that are comparable between runs
+ */
+TEST_CASE( "turn_benchmark", "[.][turn][benchmark]" )
+{
+    const int zombies = benchmark_setting( "zombies", 100 );
+    const int npcs = benchmark_setting( "npcs", 5 );
+    const int turns = benchmark_setting( "turns", 200 );
+    rng_set_engine_seed( benchmark_setting( "seed", 42 ) );
+
+    clear_map();
+    clear_avatar();
+    set_time( calendar::turn_zero + 12_hours );
+    avatar &you = get_avatar();
+    // Nothing in the scenario should end the game
+    you.set_mutation( trait_id( "DEBUG_NODMG" ) );
+    const tripoint center = you.pos();
+
+    build_burning_house( center + point( 12, -20 ) );
+    for( int i = 0; i < zombies; ++i ) {
+        // Spread over a ring around the player, away from the house
+        const int radius = 20 + i % 20;
+        const tripoint p = center + point( ( i % 2 == 0 ? -radius : radius ), ( i / 2 ) % 41 - 20 );
+        if( get_map().passable( p ) && g->critter_at( p ) == nullptr ) {
+            spawn_test_monster( "mon_zombie", p );
+        }
+    }
+    for( int i = 0; i < npcs; ++i ) {
+        spawn_npc( center.xy() + point( -5 + 2 * i, 10 ), "thug" );
+    }
+    vehicle *const car = get_map().add_vehicle( vproto_id( "car" ), center + point( -30, 25 ), 0,
+                         0, 0, false );
+    REQUIRE( car != nullptr );
+
+    const bool profiler_was_enabled = turn_profiler::enabled();
+    turn_profiler::clear();
+    turn_profiler::set_enabled( true );
+    const auto start = std::chrono::steady_clock::now();
+    for( int turn = 0; turn < turns; ++turn ) {
+        // Keep the car driving in circles
+        car->velocity = 800;
+        car->turn( 15 );
+        // The player never acts, so the turn doesn't wait for input
+        you.set_moves( 0 );
+        REQUIRE_FALSE( g->do_turn() );
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    turn_profiler::next_turn();
+    turn_profiler::set_enabled( profiler_was_enabled );
+
+    std::string report = string_format( "%d turns in %.3f s, %.1f turns/s\n", turns,
+                                        elapsed.count(), turns / elapsed.count() );
+    report += string_format( "%-40s %10s %10s %8s\n", "zone", "avg ms", "max ms", "calls" );
+    for( const turn_profiler::zone_average &avg : turn_profiler::averages() ) {
+        report += string_format( "%-40s %10.3f %10.3f %8.1f\n", avg.name, avg.milliseconds,
+                                 avg.max_milliseconds, avg.calls );
+    }
+    WARN( report );
+    turn_profiler::clear();
+}
@@ -0,0 +1,63 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "json.h"
+#include "turn_profiler.h"
+
+static void outer_zone()
+{
+    CATA_PROFILE_ZONE( "profiler_test_outer" );
+    for( int i = 0; i < 3; ++i ) {
+        CATA_PROFILE_ZONE( "profiler_test_inner" );
+    }
+}
+
+TEST_CASE( "turn_profiler_records_zones", "[profiler]" )
+{
+    turn_profiler::clear();
+
+    SECTION( "nothing is recorded while disabled" ) {
+        outer_zone();
+        turn_profiler::next_turn();
+        CHECK( turn_profiler::recorded_turns() == 0 );
+        CHECK( turn_profiler::averages().empty() );
+    }
+
+    SECTION( "zones are averaged over turns" ) {
+        turn_profiler::set_enabled( true );
+        outer_zone();
+        turn_profiler::next_turn();
+        outer_zone();
+        outer_zone();
+        turn_profiler::next_turn();
+        turn_profiler::set_enabled( false );
+
+        CHECK( turn_profiler::recorded_turns() == 2 );
+        const std::vector<turn_profiler::zone_average> averages = turn_profiler::averages();
+        REQUIRE( averages.size() == 2 );
+        // The outer zone contains the inner one
+        CHECK( averages[0].name == "profiler_test_outer" );
+        CHECK( averages[0].calls == Approx( 1.5 ) );
+        CHECK( averages[1].name == "profiler_test_inner" );
+        CHECK( averages[1].calls == Approx( 4.5 ) );
+        CHECK( averages[0].milliseconds >= averages[1].milliseconds );
+
+        std::ostringstream trace;
+        turn_profiler::write_trace( trace );
+        std::istringstream trace_in( trace.str() );
+        JsonIn jsin( trace_in );
+        JsonObject jo = jsin.get_object();
+        jo.allow_omitted_members();
+        JsonArray events = jo.get_array( "traceEvents" );
+        CHECK( events.size() == 12 );
+        for( JsonObject event : events ) {
+            event.allow_omitted_members();
+            CHECK( event.get_string( "ph" ) == "X" );
+            CHECK( event.get_float( "dur" ) >= 0.0 );
+        }
+    }
+
+    turn_profiler::clear();
+}
@@ -8,7 +8,9 @@
 #include <utility>
 #include <vector>
 
+#include "cached_options.h"
 #include "calendar.h"
+#include "cata_utility.h"
 #include "catch/catch.hpp"
 #include "character.h"
 #include "field.h"
@@ -22,6 +24,7 @@
 #include "point.h"
 #include "shadowcasting.h"
 #include "type_id.h"
+#include "worker_pool.h"
 
 enum class vision_test_flags {
     none = 0,
@@ -620,3 +623,94 @@ TEST_CASE( "vision_player_opaque_neighbors_still_visible_night", "[shadowcasting
 
     t.test_all();
 }
+
+static std::vector<float> lightmap_values( const int zlev )
+{
+    const level_cache &cache = get_map().get_cache_ref( zlev );
+    std::vector<float> result;
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            result.insert( result.end(), cache.lm[x][y].values.begin(), cache.lm[x][y].values.end() );
+            result.push_back( cache.sm[x][y] );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "lightmap_recasts_changed_light", "[shadowcasting][vision]" )
+{
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+
+    map &here = get_map();
+    clear_map();
+    set_time( midnight );
+
+    const tripoint lamp( 60, 60, 0 );
+    const tripoint wall = lamp + point_east * 2;
+    // Compares the lightmap built from the light of the previous build with one built from scratch
+    const auto matches_full_rebuild = [&here]() {
+        here.build_map_cache( 0 );
+        const std::vector<float> incremental = lightmap_values( 0 );
+        here.set_transparency_cache_dirty( 0 );
+        here.build_map_cache( 0 );
+        return incremental == lightmap_values( 0 );
+    };
+
+    // The moon lights everything a bit, depending on its phase
+    here.build_map_cache( 0 );
+    const float moonlight = here.ambient_light_at( lamp );
+
+    here.ter_set( lamp, t_utility_light );
+    CHECK( matches_full_rebuild() );
+    const float lit_lamp = here.ambient_light_at( lamp );
+    const float lit_behind_wall = here.ambient_light_at( wall + point_east );
+    CHECK( lit_behind_wall > moonlight );
+
+    here.ter_set( wall, t_brick_wall );
+    CHECK( matches_full_rebuild() );
+    CHECK( here.ambient_light_at( wall + point_east ) < lit_behind_wall );
+
+    here.ter_set( lamp + point_south * 40, t_utility_light );
+    CHECK( matches_full_rebuild() );
+
+    here.ter_set( lamp, t_floor );
+    CHECK( matches_full_rebuild() );
+    CHECK( here.ambient_light_at( lamp ) < lit_lamp );
+}
+
+TEST_CASE( "parallel_shadowcasting_matches_serial", "[shadowcasting][vision]" )
+{
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+
+    map &here = get_map();
+    clear_map();
+    set_time( midnight );
+    for( int i = 0; i < 10; ++i ) {
+        here.ter_set( tripoint( 30 + i * 7, 40 + i * 5, 0 ), t_utility_light );
+        here.ter_set( tripoint( 33 + i * 7, 40 + i * 5, 0 ), t_brick_wall );
+    }
+
+    const auto rebuild = [&here]() {
+        here.set_transparency_cache_dirty( 0 );
+        here.set_seen_cache_dirty( 0 );
+        here.build_map_cache( 0 );
+        const level_cache &cache = here.get_cache_ref( 0 );
+        std::vector<float> result = lightmap_values( 0 );
+        result.insert( result.end(), &cache.seen_cache[0][0], &cache.seen_cache[0][0] +
+                       MAPSIZE_X * MAPSIZE_Y );
+        return result;
+    };
+
+    // Several threads even on a single core, or both runs would be serial
+    worker_pool pool( 3 );
+    const worker_pool_override use_pool( pool );
+    restore_on_out_of_scope<bool> restore_parallel( parallel_shadowcasting );
+    parallel_shadowcasting = false;
+    const std::vector<float> serial = rebuild();
+    parallel_shadowcasting = true;
+    const std::vector<float> parallel = rebuild();
+    CHECK( serial == parallel );
+}
@@ -0,0 +1,43 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "worker_pool.h"
+
+TEST_CASE( "worker_pool_runs_every_task_once", "[worker_pool]" )
+{
+    const unsigned workers = GENERATE( 0u, 1u, 3u );
+    worker_pool pool( workers );
+    CHECK( pool.threads() == workers + 1 );
+
+    std::vector<std::atomic<int>> calls( 1000 );
+    for( std::atomic<int> &c : calls ) {
+        c = 0;
+    }
+    for( int round = 0; round < 3; ++round ) {
+        pool.run( calls.size(), [&calls]( const size_t i ) {
+            calls[i]++;
+        } );
+    }
+    for( const std::atomic<int> &c : calls ) {
+        CHECK( c == 3 );
+    }
+
+    SECTION( "exceptions reach the caller after all tasks ran" ) {
+        std::atomic<size_t> ran( 0 );
+        CHECK_THROWS_AS( pool.run( 100, [&ran]( const size_t i ) {
+            ran++;
+            if( i == 50 ) {
+                throw std::runtime_error( "task failed" );
+            }
+        } ), std::runtime_error );
+        CHECK( ran == 100 );
+        // Still usable afterwards
+        pool.run( 10, [&ran]( size_t ) {
+            ran++;
+        } );
+        CHECK( ran == 110 );
+    }
+}